@@ -0,0 +1,643 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include "number-elite.h"
+using namespace std;
+using namespace number_elite;
+
+// Keeps results alive so the optimizer cannot drop the work being timed
+volatile uint64_t benchmarkSink;
+
+// One timed case for one argument: op is run repeatedly and returns a
+// checksum, itemsPerOp is the work one call does (numbers sieved, ...)
+struct Benchmark {
+    string name;
+    int64_t arg;
+    function<uint64_t()> op;
+    double itemsPerOp;
+};
+
+struct BenchmarkResult {
+    string name;
+    uint64_t iterations = 0;
+    double realNs = 0, cpuNs = 0;
+    double itemsPerSecond = 0;
+    long peakRssKb = 0;
+    double allocationsPerOp = 0;
+    bool haveCounters = false;
+    double cyclesPerOp = 0, instructionsPerOp = 0, cacheMissesPerOp = 0, branchMissesPerOp = 0;
+};
+
+// ---- Hardware counters ----
+
+// Cycles, instructions, cache misses and branch misses for the calling thread,
+// read as one perf_event group. Unavailable (no kernel support, or
+// perf_event_paranoid too strict) simply means no counter columns.
+class PerfCounters {
+public:
+    static const int COUNT = 4;
+    
+    PerfCounters() {
+#ifdef __linux__
+        const uint64_t events[COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < COUNT; i++) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = events[i];
+            attr.disabled = i == 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0);
+            if (fds[i] < 0) {
+                close();
+                return;
+            }
+        }
+#endif
+    }
+    
+    ~PerfCounters() { close(); }
+    
+    bool available() const { return fds[0] >= 0; }
+    
+    void start() {
+#ifdef __linux__
+        if (!available()) return;
+        ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+    
+    // Stops counting and returns false if the group could not be read
+    bool stop(uint64_t values[COUNT]) {
+#ifdef __linux__
+        if (!available()) return false;
+        ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        uint64_t buffer[1 + COUNT];
+        if (read(fds[0], buffer, sizeof(buffer)) != sizeof(buffer)) return false;
+        for (int i = 0; i < COUNT; i++) values[i] = buffer[1 + i];
+        return true;
+#else
+        return false;
+#endif
+    }
+    
+private:
+    int fds[COUNT] = {-1, -1, -1, -1};
+    
+    void close() {
+        for (int& fd : fds) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+    }
+};
+
+// ---- Memory ----
+
+// Every operator new in the process is counted, so a benchmark can show that
+// its steady state makes no heap allocations
+atomic<uint64_t> heapAllocations{0};
+
+void* operator new(size_t bytes) {
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(bytes ? bytes : 1)) return p;
+    throw bad_alloc();
+}
+
+// std::pmr::new_delete_resource allocates through the aligned form
+void* operator new(size_t bytes, align_val_t alignment) {
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+    size_t align = max<size_t>((size_t)alignment, sizeof(void*));
+    if (void* p = aligned_alloc(align, (bytes + align - 1) / align * align)) return p;
+    throw bad_alloc();
+}
+
+// Out of line so the compiler does not pair an inlined free with a new-expression
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void* p, align_val_t) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t, align_val_t) noexcept { free(p); }
+
+// Resets the kernel's peak RSS mark so the next reading covers one benchmark
+// only; older kernels ignore this and the peak stays process-wide
+void resetPeakRss() {
+    ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs) clearRefs << "5";
+}
+
+// Peak resident set size in KB since the last reset
+long peakRssKb() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return atol(line.c_str() + 6);
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+double cpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ---- Runner ----
+
+// Doubles the iteration count until a batch takes at least minSeconds, the way
+// Google Benchmark sizes its runs, then reports that final batch
+BenchmarkResult runBenchmark(const Benchmark& benchmark, double minSeconds, PerfCounters& counters) {
+    BenchmarkResult result{benchmark.name + "/" + to_string(benchmark.arg)};
+    resetPeakRss();
+    
+    for (uint64_t iterations = 1;; iterations *= 2) {
+        uint64_t checksum = 0;
+        uint64_t values[PerfCounters::COUNT];
+        uint64_t allocationsStart = heapAllocations.load(memory_order_relaxed);
+        double cpuStart = cpuSeconds();
+        counters.start();
+        auto start = chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; i++) checksum += benchmark.op();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        bool counted = counters.stop(values);
+        double cpu = cpuSeconds() - cpuStart;
+        uint64_t allocations = heapAllocations.load(memory_order_relaxed) - allocationsStart;
+        benchmarkSink = checksum;
+        
+        if (seconds >= minSeconds || iterations >= (1ull << 40)) {
+            result.iterations = iterations;
+            result.realNs = seconds * 1e9 / iterations;
+            result.cpuNs = cpu * 1e9 / iterations;
+            result.itemsPerSecond = benchmark.itemsPerOp * iterations / seconds;
+            result.allocationsPerOp = (double)allocations / iterations;
+            result.haveCounters = counted;
+            if (counted) {
+                result.cyclesPerOp = (double)values[0] / iterations;
+                result.instructionsPerOp = (double)values[1] / iterations;
+                result.cacheMissesPerOp = (double)values[2] / iterations;
+                result.branchMissesPerOp = (double)values[3] / iterations;
+            }
+            break;
+        }
+    }
+    
+    result.peakRssKb = peakRssKb();
+    return result;
+}
+
+// ---- Registered benchmarks ----
+
+// Inputs of roughly the given size for the per-number functions, cycled
+// through so one call handles one value
+class InputPool {
+public:
+    InputPool(int64_t low, int64_t high, size_t size = 1024) : values(size) {
+        mt19937_64 rng(low * 31 + high);
+        uniform_int_distribution<int64_t> pick(low, high);
+        for (int64_t& v : values) v = pick(rng);
+    }
+    
+    int64_t next() { return values[position++ & (values.size() - 1)]; }
+    
+private:
+    vector<int64_t> values;
+    size_t position = 0;
+};
+
+// The recursive Euclid formulations gcd and extendedGCD replaced, kept as
+// the baseline for the binary and iterative versions
+int64_t recursiveGcd(int64_t a, int64_t b) {
+    return b == 0 ? a : recursiveGcd(b, a % b);
+}
+
+int64_t recursiveExtendedGCD(int64_t a, int64_t b, int64_t& x, int64_t& y) {
+    if (b == 0) {
+        x = 1;
+        y = 0;
+        return a;
+    }
+    int64_t x1, y1;
+    int64_t g = recursiveExtendedGCD(b, a % b, x1, y1);
+    x = y1;
+    y = x1 - (a / b) * y1;
+    return g;
+}
+
+// The trial-division findAllDivisors that divisor enumeration from the
+// factorization replaced
+vector<uint64_t> trialDivisors(uint64_t n) {
+    vector<uint64_t> divisors;
+    for (uint64_t i = 1; i <= n / i; i++) {
+        if (n % i == 0) {
+            divisors.push_back(i);
+            if (n / i != i) divisors.push_back(n / i);
+        }
+    }
+    return divisors;
+}
+
+vector<Benchmark> registerBenchmarks() {
+    vector<Benchmark> benchmarks;
+    auto add = [&](const string& name, vector<int64_t> args, function<function<uint64_t()>(int64_t)> make,
+                   function<double(int64_t)> items) {
+        for (int64_t arg : args) benchmarks.push_back({name, arg, make(arg), items(arg)});
+    };
+    auto perNumber = [](int64_t) { return 1.0; };
+    auto perBound = [](int64_t n) { return (double)n; };
+    
+    // Sieves: one op sieves [0, n]
+    vector<int64_t> sieveSizes = {1 << 10, 1 << 16, 1 << 20, 1 << 24};
+    add("sieveOfEratosthenes", sieveSizes, [](int64_t n) {
+        return [n] { return (uint64_t)extractPrimes(sieveOfEratosthenes((int)n)).size(); };
+    }, perBound);
+    add("optimizedSieve", sieveSizes, [](int64_t n) {
+        return [n] { return (uint64_t)extractPrimes(optimizedSieve((int)n)).size(); };
+    }, perBound);
+    add("linearSieve", sieveSizes, [](int64_t n) {
+        return [n] { return (uint64_t)linearSieve((int)n).size(); };
+    }, perBound);
+    add("sieveOfAtkin", sieveSizes, [](int64_t n) {
+        return [n] { return (uint64_t)sieveOfAtkin((int)n).size(); };
+    }, perBound);
+    add("wheel210Sieve", sieveSizes, [](int64_t n) {
+        return [n] { return (uint64_t)wheel210Sieve((int)n).size(); };
+    }, perBound);
+    add("segmentedSieve", sieveSizes, [](int64_t n) {
+        return [n] { return (uint64_t)segmentedSieve((int)n).size(); };
+    }, perBound);
+    add("PrimeBitset", sieveSizes, [](int64_t n) {
+        return [n] { PrimeBitset primes(n); return primes.count(0, n); };
+    }, perBound);
+    
+    // Growing query streams: one op answers pi(x) for x = n / 64, 2n / 64, ..., n,
+    // re-sieving [0, x] for every query or extending one LazySieve
+    const int STREAM_QUERIES = 64;
+    add("resieveQueryStream", sieveSizes, [=](int64_t n) {
+        return [=] {
+            uint64_t total = 0;
+            for (int i = 1; i <= STREAM_QUERIES; i++) total += PrimeBitset(n * i / STREAM_QUERIES).count(0, n);
+            return total;
+        };
+    }, perBound);
+    add("LazySieveQueryStream", sieveSizes, [=](int64_t n) {
+        return [=] {
+            LazySieve primes;
+            uint64_t total = 0;
+            for (int i = 1; i <= STREAM_QUERIES; i++) total += primes.primeCount(n * i / STREAM_QUERIES);
+            return total;
+        };
+    }, perBound);
+    
+    // pi(x) and its inverse: one op counts the primes up to x, or finds the
+    // k-th prime
+    add("primeCount", {1000000000, 1000000000000}, [](int64_t x) {
+        return [x] { return primeCount(x); };
+    }, perNumber);
+    add("nthPrime", {1000000, 1000000000}, [](int64_t k) {
+        return [k] { return nthPrime(k); };
+    }, perNumber);
+    
+    // Prime listing by trial division: one op lists the primes up to n
+    vector<int64_t> trialSizes = {1 << 10, 1 << 14, 1 << 17};
+    add("primeTillNSimple", trialSizes, [](int64_t n) {
+        return [n] { return (uint64_t)primeTillNSimple(n).size(); };
+    }, perBound);
+    add("primeTillNOptimized", trialSizes, [](int64_t n) {
+        return [n] { return (uint64_t)primeTillNOptimized(n).size(); };
+    }, perBound);
+    add("primeTillNSieve", trialSizes, [](int64_t n) {
+        return [n] { return (uint64_t)primeTillNSieve(n).size(); };
+    }, perBound);
+    add("primeTillN6kOptimization", trialSizes, [](int64_t n) {
+        return [n] { return (uint64_t)primeTillN6kOptimization(n).size(); };
+    }, perBound);
+    
+    // Per-number functions: one op handles one random input near the argument
+    vector<int64_t> magnitudes = {1000, 1000000, 1000000000};
+    add("countDivisors", magnitudes, [](int64_t size) {
+        auto pool = make_shared<InputPool>(size / 2, size);
+        return [pool] { return (uint64_t)countDivisors(pool->next()); };
+    }, perNumber);
+    add("countDivisorsOptimized", magnitudes, [](int64_t size) {
+        auto pool = make_shared<InputPool>(size / 2, size);
+        return [pool] { return (uint64_t)countDivisorsOptimized(pool->next()); };
+    }, perNumber);
+    add("isPrimeMillerRabin", {1000, 60000, 1000000000, 1000000000000000000}, [](int64_t size) {
+        auto pool = make_shared<InputPool>(size / 2, size);
+        return [pool] { return (uint64_t)isPrimeMillerRabin(pool->next()); };
+    }, perNumber);
+    add("eulerTotient", magnitudes, [](int64_t size) {
+        auto pool = make_shared<InputPool>(size / 2, size);
+        return [pool] { return (uint64_t)eulerTotient(pool->next()); };
+    }, perNumber);
+    add("primeFactorization", {1000, 1000000000, 1000000000000000000}, [](int64_t size) {
+        auto pool = make_shared<InputPool>(size / 2, size);
+        return [pool] {
+            return (uint64_t)primeFactorization((unsigned long long)pool->next()).size();
+        };
+    }, perNumber);
+    
+    // Divisor lists of highly composite numbers (240, 6720 and 103680
+    // divisors): one op lists every divisor of the argument
+    vector<int64_t> compositeSizes = {720720, 963761198400};
+    add("trialDivisors", compositeSizes, [](int64_t n) {
+        return [n] { return (uint64_t)trialDivisors(n).size(); };
+    }, perNumber);
+    compositeSizes.push_back(897612484786617600);
+    add("sortedDivisors", compositeSizes, [](int64_t n) {
+        return [n] { return (uint64_t)sortedDivisors(n).size(); };
+    }, perNumber);
+    add("divisorsInto", compositeSizes, [](int64_t n) {
+        Factorization64 f = factorization64(n);
+        auto out = make_shared<vector<uint64_t>>(divisorCount(f));
+        return [f, out] { return (uint64_t)divisorsInto(f, out->data()); };
+    }, perNumber);
+    
+    // The same queries on the calling thread's Arena, reset before each one:
+    // once it has grown to fit, the Allocs/op column should read 0
+    vector<int64_t> smallSieveSizes = {1 << 10, 1 << 16};
+    add("segmentedSieveArena", smallSieveSizes, [](int64_t n) {
+        return [n] {
+            threadArena().reset();
+            return (uint64_t)segmentedSieve((int)n, &threadArena()).size();
+        };
+    }, perBound);
+    add("linearSieveArena", smallSieveSizes, [](int64_t n) {
+        return [n] {
+            threadArena().reset();
+            return (uint64_t)linearSieve((int)n, &threadArena()).size();
+        };
+    }, perBound);
+    add("primeFactorizationArena", {1000, 1000000000, 1000000000000000000}, [](int64_t size) {
+        auto pool = make_shared<InputPool>(size / 2, size);
+        return [pool] {
+            threadArena().reset();
+            return (uint64_t)primeFactorization((unsigned long long)pool->next(), &threadArena()).size();
+        };
+    }, perNumber);
+    add("findAllDivisorsArena", compositeSizes, [](int64_t n) {
+        return [n] {
+            threadArena().reset();
+            return (uint64_t)findAllDivisors((uint64_t)n, &threadArena()).size();
+        };
+    }, perNumber);
+    
+    // Batch primality: one op tests 65536 random values below the argument,
+    // against isPrimeTrialDivision called on each in turn
+    const size_t PRIMALITY_BATCH = 1 << 16;
+    vector<int64_t> batchBounds = {1 << 20, 4294967295};
+    auto batchValues = [=](int64_t bound) {
+        auto pool = make_shared<InputPool>(2, bound, PRIMALITY_BATCH);
+        auto values = make_shared<vector<uint32_t>>(PRIMALITY_BATCH);
+        for (auto& value : *values) value = pool->next();
+        return values;
+    };
+    auto perBatch = [=](int64_t) { return (double)PRIMALITY_BATCH; };
+    add("isPrimeTrialDivisionLoop", batchBounds, [=](int64_t bound) {
+        auto values = batchValues(bound);
+        return [values] {
+            uint64_t count = 0;
+            for (uint32_t value : *values) count += isPrimeTrialDivision(value);
+            return count;
+        };
+    }, perBatch);
+    add("isPrimeBatchScalar", batchBounds, [=](int64_t bound) {
+        auto values = batchValues(bound);
+        auto results = make_shared<vector<uint8_t>>(PRIMALITY_BATCH);
+        return [values, results] {
+            isPrimeBatchScalar(values->data(), values->size(), results->data());
+            return (uint64_t)(*results)[0];
+        };
+    }, perBatch);
+    add("isPrimeBatch", batchBounds, [=](int64_t bound) {
+        auto values = batchValues(bound);
+        auto results = make_shared<vector<uint8_t>>(PRIMALITY_BATCH);
+        return [values, results] {
+            isPrimeBatch(values->data(), values->size(), results->data());
+            return (uint64_t)(*results)[0];
+        };
+    }, perBatch);
+    
+    // fastPower with a random 62-bit modulus; the argument is the exponent size in bits
+    add("fastPower", {8, 32, 62}, [](int64_t bits) {
+        auto pool = make_shared<InputPool>(1ll << (bits - 1), (1ll << bits) - 1);
+        auto mods = make_shared<InputPool>(1ll << 61, (1ll << 62) - 1);
+        return [pool, mods] { return (uint64_t)fastPower(pool->next(), pool->next(), mods->next()); };
+    }, perNumber);
+    
+    // GCDs of two random numbers of the argument's size in bits
+    vector<int64_t> gcdBits = {32, 62};
+    auto bitsPool = [](int64_t bits) { return make_shared<InputPool>(1ll << (bits - 1), (1ll << bits) - 1); };
+    add("recursiveGcd", gcdBits, [&](int64_t bits) {
+        auto pool = bitsPool(bits);
+        return [pool] { return (uint64_t)recursiveGcd(pool->next(), pool->next()); };
+    }, perNumber);
+    add("gcd", gcdBits, [&](int64_t bits) {
+        auto pool = bitsPool(bits);
+        return [pool] { return (uint64_t)gcd(pool->next(), pool->next()); };
+    }, perNumber);
+    add("recursiveExtendedGCD", gcdBits, [&](int64_t bits) {
+        auto pool = bitsPool(bits);
+        return [pool] {
+            int64_t x, y;
+            return (uint64_t)(recursiveExtendedGCD(pool->next(), pool->next(), x, y) + x);
+        };
+    }, perNumber);
+    add("extendedGCD", gcdBits, [&](int64_t bits) {
+        auto pool = bitsPool(bits);
+        return [pool] {
+            int64_t x, y;
+            return (uint64_t)(extendedGCD(pool->next(), pool->next(), x, y) + x);
+        };
+    }, perNumber);
+    
+    // Inverting a batch of the argument's size modulo 10^9 + 7, one extended
+    // GCD per element against one for the whole batch
+    const uint64_t INVERSE_MOD = 1000000007;
+    vector<int64_t> batchSizes = {1 << 10, 1 << 20};
+    add("modularInverse", batchSizes, [=](int64_t n) {
+        auto pool = make_shared<InputPool>(1, INVERSE_MOD - 1);
+        auto values = make_shared<vector<uint64_t>>(n);
+        for (auto& value : *values) value = pool->next();
+        return [values, INVERSE_MOD] {
+            uint64_t sum = 0;
+            for (uint64_t value : *values) sum += modularInverse(value, INVERSE_MOD);
+            return sum;
+        };
+    }, perBound);
+    add("batchModularInverse", batchSizes, [=](int64_t n) {
+        auto pool = make_shared<InputPool>(1, INVERSE_MOD - 1);
+        auto values = make_shared<vector<uint64_t>>(n);
+        for (auto& value : *values) value = pool->next();
+        auto inverses = make_shared<vector<uint64_t>>(n);
+        return [values, inverses, INVERSE_MOD] {
+            batchModularInverse(values->data(), values->size(), INVERSE_MOD, inverses->data());
+            return (*inverses)[0];
+        };
+    }, perBound);
+    
+    // C(n, r) mod 10^9 + 7 for random r <= n and n below the argument: a
+    // factorial table with one Fermat inverse per query against the inverse
+    // factorial table
+    const uint64_t BINOMIAL_MOD = 1000000007;
+    vector<int64_t> binomialSizes = {1000, 1000000};
+    add("binomialFermat", binomialSizes, [=](int64_t size) {
+        auto table = make_shared<FactorialTable>(BINOMIAL_MOD, size);
+        auto pool = make_shared<InputPool>(0, size);
+        return [table, pool, BINOMIAL_MOD] {
+            uint64_t n = pool->next(), r = pool->next() % (n + 1);
+            uint64_t denominator = mulMod(table->factorial(r), table->factorial(n - r), BINOMIAL_MOD);
+            return mulMod(table->factorial(n), powerMod(denominator, BINOMIAL_MOD - 2, BINOMIAL_MOD), BINOMIAL_MOD);
+        };
+    }, perNumber);
+    add("FactorialTable::binomial", binomialSizes, [=](int64_t size) {
+        auto table = make_shared<FactorialTable>(BINOMIAL_MOD, size);
+        auto pool = make_shared<InputPool>(0, size);
+        return [table, pool] {
+            uint64_t n = pool->next(), r = pool->next() % (n + 1);
+            return table->binomial(n, r);
+        };
+    }, perNumber);
+    
+    // wilsonTheorem is linear in p; one op checks one number near the argument
+    add("wilsonTheorem", {1000, 100000}, [](int64_t size) {
+        auto pool = make_shared<InputPool>(size / 2, size);
+        return [pool] { return (uint64_t)wilsonTheorem(pool->next()); };
+    }, perNumber);
+    
+    return benchmarks;
+}
+
+// ---- Reporting ----
+
+string jsonEscape(const string& text) {
+    string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Layout follows Google Benchmark's JSON so the same diffing tools apply
+void writeJson(ostream& out, const vector<BenchmarkResult>& results) {
+    time_t now = time(nullptr);
+    char date[32];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+    
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"host_name\": \"" << jsonEscape(host) << "\",\n";
+    out << "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n";
+    out << "    \"l1_data_cache_bytes\": " << l1DataCacheSize() << "\n";
+    out << "  },\n  \"benchmarks\": [\n";
+    
+    out << setprecision(10);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& r = results[i];
+        out << "    {\n";
+        out << "      \"name\": \"" << jsonEscape(r.name) << "\",\n";
+        out << "      \"iterations\": " << r.iterations << ",\n";
+        out << "      \"real_time\": " << r.realNs << ",\n";
+        out << "      \"cpu_time\": " << r.cpuNs << ",\n";
+        out << "      \"time_unit\": \"ns\",\n";
+        out << "      \"items_per_second\": " << r.itemsPerSecond << ",\n";
+        if (r.haveCounters) {
+            out << "      \"cycles\": " << r.cyclesPerOp << ",\n";
+            out << "      \"instructions\": " << r.instructionsPerOp << ",\n";
+            out << "      \"cache_misses\": " << r.cacheMissesPerOp << ",\n";
+            out << "      \"branch_misses\": " << r.branchMissesPerOp << ",\n";
+        }
+        out << "      \"allocations\": " << r.allocationsPerOp << ",\n";
+        out << "      \"peak_rss_kb\": " << r.peakRssKb << "\n";
+        out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void printRow(const BenchmarkResult& r) {
+    cout << left << setw(36) << r.name << right << fixed << setprecision(1) << setw(16) << r.realNs
+         << setw(16) << r.cpuNs << setw(12) << r.iterations << setprecision(3) << setw(12)
+         << r.itemsPerSecond / 1e6 << setw(12) << r.peakRssKb << setprecision(1) << setw(12) << r.allocationsPerOp;
+    if (r.haveCounters) {
+        cout << setprecision(1) << setw(14) << r.cyclesPerOp << setw(8) << setprecision(2)
+             << r.instructionsPerOp / max(r.cyclesPerOp, 1.0);
+    }
+    cout << endl;
+}
+
+int main(int argc, char** argv) {
+    string filter, jsonPath;
+    double minSeconds = 0.2;
+    
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option.compare(0, 9, "--filter=") == 0) {
+            filter = option.substr(9);
+        } else if (option.compare(0, 7, "--json=") == 0) {
+            jsonPath = option.substr(7);
+        } else if (option.compare(0, 11, "--min-time=") == 0) {
+            minSeconds = atof(option.c_str() + 11);
+        } else {
+            cerr << "usage: " << argv[0] << " [--filter=substring] [--json=file] [--min-time=seconds]" << endl;
+            return 1;
+        }
+    }
+    
+    PerfCounters counters;
+    cout << "=== Number-Elite Benchmarks ===" << endl;
+    if (!counters.available()) cout << "(hardware counters unavailable: perf_event_open failed)" << endl;
+    cout << left << setw(36) << "Benchmark" << right << setw(16) << "Time (ns)" << setw(16) << "CPU (ns)"
+         << setw(12) << "Iterations" << setw(12) << "M items/s" << setw(12) << "Peak KB" << setw(12) << "Allocs/op";
+    if (counters.available()) cout << setw(14) << "Cycles" << setw(8) << "IPC";
+    cout << endl;
+    
+    vector<BenchmarkResult> results;
+    for (const Benchmark& benchmark : registerBenchmarks()) {
+        string name = benchmark.name + "/" + to_string(benchmark.arg);
+        if (name.find(filter) == string::npos) continue;
+        results.push_back(runBenchmark(benchmark, minSeconds, counters));
+        printRow(results.back());
+    }
+    
+    if (!jsonPath.empty()) {
+        ofstream json(jsonPath);
+        if (!json) {
+            cerr << "cannot write " << jsonPath << endl;
+            return 1;
+        }
+        writeJson(json, results);
+        cout << "Results written to " << jsonPath << endl;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace number_elite {
+
+// Monotonic arena for one query at a time: allocations bump a pointer through
+// a list of chunks, deallocation is free, and reset() rewinds to the first
+// chunk while keeping every chunk. Once the chunks cover the largest query,
+// later queries make no calls to the upstream allocator at all, which
+// upstreamAllocations() lets callers check. Any std::pmr container can use
+// it; releasing the most recent allocation hands its bytes back, so a
+// container that grows last reuses its old space. Not thread-safe: use one
+// arena per thread (threadArena).
+class Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(size_t initialBytes = 64 * 1024,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream(upstream), nextChunkBytes(initialBytes < 64 ? 64 : initialBytes) {}
+    
+    ~Arena() override {
+        for (const Chunk& chunk : chunks) upstream->deallocate(chunk.data, chunk.bytes, alignof(std::max_align_t));
+    }
+    
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    
+    // Forgets every allocation; memory handed out before is reused
+    void reset() {
+        current = 0;
+        used = 0;
+        lastAllocation = nullptr;
+    }
+    
+    // Calls made to the upstream allocator since construction
+    uint64_t upstreamAllocations() const { return upstreamCalls; }
+    
+    // Bytes held in chunks, and bytes handed out since the last reset
+    size_t bytesReserved() const {
+        size_t total = 0;
+        for (const Chunk& chunk : chunks) total += chunk.bytes;
+        return total;
+    }
+    size_t bytesInUse() const {
+        size_t total = used;
+        for (size_t i = 0; i < current && i < chunks.size(); i++) total += chunks[i].bytes;
+        return total;
+    }
+    
+private:
+    struct Chunk {
+        char* data;
+        size_t bytes;
+    };
+    
+    std::pmr::memory_resource* upstream;
+    std::vector<Chunk> chunks;
+    size_t current = 0;          // chunk being bumped through
+    size_t used = 0;             // bytes used in chunks[current]
+    size_t nextChunkBytes;
+    void* lastAllocation = nullptr;
+    uint64_t upstreamCalls = 0;
+    
+    // First offset >= used in data at which an allocation is suitably aligned
+    static size_t alignedOffset(const char* data, size_t used, size_t alignment) {
+        uintptr_t address = (uintptr_t)(data + used);
+        return used + (size_t)(-address & (alignment - 1));
+    }
+    
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        while (current < chunks.size()) {
+            const Chunk& chunk = chunks[current];
+            size_t start = alignedOffset(chunk.data, used, alignment);
+            if (start + bytes <= chunk.bytes) {
+                used = start + bytes;
+                return lastAllocation = chunk.data + start;
+            }
+            current++;
+            used = 0;
+        }
+        
+        // No kept chunk has room: add one at least twice the last, big enough
+        // for this request at any alignment
+        size_t chunkBytes = nextChunkBytes;
+        while (chunkBytes < bytes + alignment) chunkBytes *= 2;
+        nextChunkBytes = chunkBytes * 2;
+        char* data = (char*)upstream->allocate(chunkBytes, alignof(std::max_align_t));
+        upstreamCalls++;
+        chunks.push_back({data, chunkBytes});
+        current = chunks.size() - 1;
+        
+        size_t start = alignedOffset(data, 0, alignment);
+        used = start + bytes;
+        return lastAllocation = data + start;
+    }
+    
+    void do_deallocate(void* p, size_t, size_t) override {
+        if (p == lastAllocation && current < chunks.size()) {
+            used = (char*)p - chunks[current].data;
+            lastAllocation = nullptr;
+        }
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// The calling thread's arena. A query resets it, allocates everything from
+// it, and copies out what must outlive the next reset.
+inline Arena& threadArena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+} // namespace number_elite
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "small-primes.h"
+#include "miller-rabin.h"
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+namespace number_elite {
+
+// Primality of many 32-bit values at once. isPrimeBatch writes results[i] = 1
+// if values[i] is prime and 0 otherwise. On x86-64 CPUs with AVX2 (checked at
+// run time, so the default build flags suffice) eight values go through each
+// step together:
+//   1. values below 2^16 are read from the SMALL_PRIMES bitmap with a gather;
+//   2. larger values are tested for divisibility by the odd primes up to 137
+//      with one multiplication each, n divisible by p exactly when
+//      n * p^-1 mod 2^32 <= (2^32 - 1) / p, so no division is executed;
+//   3. the survivors, about one in nine, are packed into full vectors and
+//      finished by Miller-Rabin with bases {2, 7, 61} in 32-bit Montgomery
+//      form across the lanes.
+// Other CPUs run isPrimeBatchScalar, which gives the same answers.
+
+// Portable path: the scalar test on every value
+inline void isPrimeBatchScalar(const uint32_t* values, size_t count, uint8_t* results) {
+    for (size_t i = 0; i < count; i++) results[i] = isPrimeMillerRabin(values[i]);
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+// Odd primes tested in step 2, with p^-1 mod 2^32 and (2^32 - 1) / p
+struct BatchFilterPrimes {
+    static const int COUNT = 32;
+    uint32_t inverse[COUNT];
+    uint32_t quotient[COUNT];
+    
+    BatchFilterPrimes() {
+        for (int i = 0; i < COUNT; i++) {
+            uint32_t p = SMALL_PRIMES.primes[i + 1];
+            uint32_t x = p;
+            for (int k = 0; k < 4; k++) x *= 2 - p * x;
+            inverse[i] = x;
+            quotient[i] = UINT32_MAX / p;
+        }
+    }
+};
+
+inline const BatchFilterPrimes& batchFilterPrimes() {
+    static const BatchFilterPrimes primes;
+    return primes;
+}
+
+// x >= y for unsigned 32-bit lanes, as all-ones lanes
+__attribute__((target("avx2"))) inline __m256i greaterOrEqual8(__m256i x, __m256i y) {
+    return _mm256_cmpeq_epi32(_mm256_max_epu32(x, y), x);
+}
+
+// a * b * 2^-32 mod n in every lane, for a, b < n odd: the high half of a * b
+// minus that of m * n, where m = lo(a * b) * n^-1 makes the low halves equal
+__attribute__((target("avx2"))) inline __m256i montgomeryMultiply8(__m256i a, __m256i b, __m256i n,
+                                                                  __m256i nInverse) {
+    __m256i productEven = _mm256_mul_epu32(a, b);
+    __m256i productOdd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    __m256i m = _mm256_mullo_epi32(_mm256_mullo_epi32(a, b), nInverse);
+    __m256i mnEven = _mm256_mul_epu32(m, n);
+    __m256i mnOdd = _mm256_mul_epu32(_mm256_srli_epi64(m, 32), _mm256_srli_epi64(n, 32));
+    
+    __m256i productHigh = _mm256_blend_epi32(_mm256_srli_epi64(productEven, 32), productOdd, 0xAA);
+    __m256i mnHigh = _mm256_blend_epi32(_mm256_srli_epi64(mnEven, 32), mnOdd, 0xAA);
+    __m256i difference = _mm256_sub_epi32(productHigh, mnHigh);
+    return _mm256_add_epi32(difference, _mm256_andnot_si256(greaterOrEqual8(productHigh, mnHigh), n));
+}
+
+// x + y mod n in every lane, for x, y < n
+__attribute__((target("avx2"))) inline __m256i addMod8(__m256i x, __m256i y, __m256i n) {
+    __m256i complement = _mm256_sub_epi32(n, y);
+    return _mm256_blendv_epi8(_mm256_add_epi32(x, y), _mm256_sub_epi32(x, complement),
+                              greaterOrEqual8(x, complement));
+}
+
+// Miller-Rabin with bases {2, 7, 61} on eight odd n in [2^16, 2^32), each
+// given with n - 1 = d * 2^s and r = 2^32 mod n (the Montgomery form of 1).
+// Returns a lane mask of the primes.
+__attribute__((target("avx2"))) inline int millerRabin8(const uint32_t* n, const uint32_t* d, const uint32_t* s,
+                                                       const uint32_t* r) {
+    __m256i modulus = _mm256_loadu_si256((const __m256i*)n);
+    __m256i exponent = _mm256_loadu_si256((const __m256i*)d);
+    __m256i shifts = _mm256_loadu_si256((const __m256i*)s);
+    __m256i one = _mm256_loadu_si256((const __m256i*)r);
+    __m256i minusOne = _mm256_sub_epi32(modulus, one);
+    
+    // n^-1 mod 2^32 by Newton's iteration, 3 correct bits doubling to 48
+    __m256i inverse = modulus, two = _mm256_set1_epi32(2);
+    for (int k = 0; k < 4; k++) {
+        inverse = _mm256_mullo_epi32(inverse, _mm256_sub_epi32(two, _mm256_mullo_epi32(modulus, inverse)));
+    }
+    
+    uint32_t exponentBits = 0, maxShift = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        exponentBits |= d[lane];
+        maxShift = std::max(maxShift, s[lane]);
+    }
+    int topBit = 31 - __builtin_clz(exponentBits);
+    
+    int prime = 0xFF;
+    for (uint32_t base : {2, 7, 61}) {
+        // base * 2^32 mod n by doubling and adding the form of 1
+        __m256i form = _mm256_setzero_si256();
+        for (int bit = 5; bit >= 0; bit--) {
+            form = addMod8(form, form, modulus);
+            if (base >> bit & 1) form = addMod8(form, one, modulus);
+        }
+        
+        __m256i x = one;
+        for (int bit = topBit; bit >= 0; bit--) {
+            x = montgomeryMultiply8(x, x, modulus, inverse);
+            __m256i multiplied = montgomeryMultiply8(x, form, modulus, inverse);
+            __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srli_epi32(exponent, bit), _mm256_set1_epi32(1)),
+                                             _mm256_set1_epi32(1));
+            x = _mm256_blendv_epi8(x, multiplied, set);
+        }
+        
+        __m256i passed = _mm256_or_si256(_mm256_cmpeq_epi32(x, one), _mm256_cmpeq_epi32(x, minusOne));
+        for (uint32_t j = 1; j < maxShift; j++) {
+            x = montgomeryMultiply8(x, x, modulus, inverse);
+            __m256i active = _mm256_cmpgt_epi32(shifts, _mm256_set1_epi32(j));
+            passed = _mm256_or_si256(passed, _mm256_and_si256(active, _mm256_cmpeq_epi32(x, minusOne)));
+        }
+        prime &= _mm256_movemask_ps(_mm256_castsi256_ps(passed));
+        if (prime == 0) break;
+    }
+    return prime;
+}
+
+// Steps 1 and 2 on blocks of eight, collecting the survivors; step 3 on the
+// survivors, eight at a time
+__attribute__((target("avx2"))) inline void isPrimeBatchAvx2(const uint32_t* values, size_t count, uint8_t* results) {
+    const BatchFilterPrimes& filter = batchFilterPrimes();
+    const int* bitmap = (const int*)SMALL_PRIMES.oddBitmap;
+    const __m256i ones = _mm256_set1_epi32(1), smallMax = _mm256_set1_epi32(SMALL_PRIME_LIMIT - 1);
+    
+    std::vector<uint32_t> survivorIndex, survivor, d, s, r;
+    auto survive = [&](size_t i) {
+        uint32_t n = values[i];
+        survivorIndex.push_back(i);
+        survivor.push_back(n);
+        int zeros = __builtin_ctz(n - 1);
+        d.push_back((n - 1) >> zeros);
+        s.push_back(zeros);
+        r.push_back((0 - n) % n);
+    };
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i n = _mm256_loadu_si256((const __m256i*)(values + i));
+        __m256i small = greaterOrEqual8(smallMax, n);
+        
+        // Bit n / 2 of the bitmap lives in 32-bit word n / 64; large lanes read word 1023
+        __m256i word = _mm256_i32gather_epi32(bitmap, _mm256_srli_epi32(_mm256_min_epu32(n, smallMax), 6), 4);
+        __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_and_si256(_mm256_srli_epi32(n, 1), _mm256_set1_epi32(31))), ones);
+        __m256i odd = _mm256_and_si256(n, ones);
+        __m256i smallPrime = _mm256_or_si256(_mm256_and_si256(bit, odd),
+                                             _mm256_and_si256(_mm256_cmpeq_epi32(n, _mm256_set1_epi32(2)), ones));
+        
+        __m256i divisible = _mm256_cmpeq_epi32(odd, _mm256_setzero_si256());
+        for (int k = 0; k < BatchFilterPrimes::COUNT; k++) {
+            __m256i product = _mm256_mullo_epi32(n, _mm256_set1_epi32(filter.inverse[k]));
+            divisible = _mm256_or_si256(divisible, greaterOrEqual8(_mm256_set1_epi32(filter.quotient[k]), product));
+        }
+        
+        alignas(32) uint32_t answer[8];
+        _mm256_store_si256((__m256i*)answer, _mm256_and_si256(smallPrime, small));
+        for (int lane = 0; lane < 8; lane++) results[i + lane] = answer[lane];
+        
+        int candidates = ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(small, divisible))) & 0xFF;
+        while (candidates) {
+            survive(i + __builtin_ctz(candidates));
+            candidates &= candidates - 1;
+        }
+    }
+    for (; i < count; i++) {
+        results[i] = isPrimeMillerRabin(values[i]);
+    }
+    
+    // Pad the last group with 65537, whose answers are not written back
+    while (survivor.size() % 8 != 0) {
+        survivor.push_back(65537);
+        d.push_back(1);
+        s.push_back(16);
+        r.push_back(1);
+    }
+    for (size_t k = 0; k < survivor.size(); k += 8) {
+        int prime = millerRabin8(&survivor[k], &d[k], &s[k], &r[k]);
+        for (int lane = 0; lane < 8 && k + lane < survivorIndex.size(); lane++) {
+            results[survivorIndex[k + lane]] = prime >> lane & 1;
+        }
+    }
+}
+
+inline void isPrimeBatch(const uint32_t* values, size_t count, uint8_t* results) {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2) {
+        isPrimeBatchAvx2(values, count, results);
+    } else {
+        isPrimeBatchScalar(values, count, results);
+    }
+}
+
+#else
+
+inline void isPrimeBatch(const uint32_t* values, size_t count, uint8_t* results) {
+    isPrimeBatchScalar(values, count, results);
+}
+
+#endif
+
+} // namespace number_elite
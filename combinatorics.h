@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "modular-arithmetic.h"
+
+namespace number_elite {
+
+// n! and (n!)^-1 modulo a prime p for every n <= limit, so binomials and
+// permutations cost two multiplications each instead of an exponentiation.
+// The tables are built with one Fermat inverse: (limit!)^-1 = limit!^(p-2),
+// then (n-1)!^-1 = n!^-1 * n sweeping down. The limit is capped at p - 1,
+// past which every factorial is 0 mod p. Arguments of any size go through
+// Lucas' theorem, one base-p digit at a time; a digit past a table that stops
+// short of p - 1 has its factorial multiplied out from the last entry.
+//
+// Products use Barrett reduction, which works for every p >= 2 including
+// p = 2.
+class FactorialTable {
+public:
+    FactorialTable(uint64_t p, uint64_t limit) : p(p), reducer(p) {
+        if (limit > p - 1) limit = p - 1;
+        factorials.resize(limit + 1);
+        inverseFactorials.resize(limit + 1);
+        
+        factorials[0] = 1 % p;
+        for (uint64_t i = 1; i <= limit; i++) {
+            factorials[i] = reducer.multiply(factorials[i - 1], i);
+        }
+        inverseFactorials[limit] = powerMod(factorials[limit], p - 2, p);
+        for (uint64_t i = limit; i > 0; i--) {
+            inverseFactorials[i - 1] = reducer.multiply(inverseFactorials[i], i);
+        }
+    }
+    
+    uint64_t modulus() const { return p; }
+    uint64_t limit() const { return factorials.size() - 1; }
+    
+    // True once the table reaches p - 1, which Lucas' theorem needs
+    bool complete() const { return limit() == p - 1; }
+    
+    // n! mod p for n <= limit, or any n with a complete table
+    uint64_t factorial(uint64_t n) const {
+        return n < factorials.size() ? factorials[n] : 0;
+    }
+    
+    // (n!)^-1 mod p for n <= limit
+    uint64_t inverseFactorial(uint64_t n) const { return inverseFactorials[n]; }
+    
+    // n^-1 mod p for 1 <= n <= limit, as (n-1)! / n!
+    uint64_t inverse(uint64_t n) const {
+        return reducer.multiply(inverseFactorials[n], factorials[n - 1]);
+    }
+    
+    // C(n, r) mod p; n above the limit costs one table lookup per base-p digit
+    // of n (Lucas' theorem). With an incomplete table a digit past the limit
+    // costs up to p - limit multiplications and one exponentiation instead.
+    uint64_t binomial(uint64_t n, uint64_t r) const {
+        if (r > n) return 0;
+        if (n <= limit()) return smallBinomial(n, r);
+        uint64_t result = 1 % p;
+        while (r > 0 && result != 0) {
+            result = reducer.multiply(result, residueBinomial(n % p, r % p));
+            n /= p;
+            r /= p;
+        }
+        return result;
+    }
+    
+    // n! / (n-r)! mod p. The product n (n-1) ... (n-r+1) runs over r
+    // consecutive residues, so it is 0 once it wraps past a multiple of p and
+    // a quotient of factorials of residues otherwise. With top = n mod p past
+    // an incomplete table that is at most top - limit multiplications: the
+    // product itself when it lies wholly past the limit, else top! multiplied
+    // out from the table times the entry (top - r)!^-1.
+    uint64_t permutations(uint64_t n, uint64_t r) const {
+        if (r > n) return 0;
+        uint64_t top = n % p;
+        if (r > top) return 0;
+        if (top - r >= limit()) {
+            uint64_t result = 1 % p;
+            for (uint64_t i = top - r + 1; i <= top; i++) result = reducer.multiply(result, i);
+            return result;
+        }
+        return reducer.multiply(residueFactorial(top), inverseFactorials[top - r]);
+    }
+    
+    // n! with every factor p removed, mod p, for any n.
+    // The multiples of p contribute (n / p)! recursively, and each full run
+    // 1 .. p-1 of the other factors contributes (p-1)! = -1 by Wilson's theorem.
+    uint64_t factorialWithoutP(uint64_t n) const {
+        uint64_t result = 1 % p;
+        while (n > 0) {
+            if ((n / p) % 2 == 1) result = reducer.multiply(result, p - 1);
+            result = reducer.multiply(result, residueFactorial(n % p));
+            n /= p;
+        }
+        return result;
+    }
+    
+    // Wilson's theorem on the modulus itself, read from a complete table:
+    // (p-1)! = -1 (mod p) exactly when p is prime. The tables are only right
+    // for a prime modulus, so this doubles as a check on the constructor input.
+    bool satisfiesWilson() const {
+        return complete() && factorials[p - 1] == p - 1;
+    }
+    
+private:
+    uint64_t p;
+    Barrett64 reducer;
+    std::vector<uint64_t> factorials, inverseFactorials;
+    
+    // a! mod p for a < p: the table entry, or for a past an incomplete table
+    // the product of limit! and limit + 1 .. a
+    uint64_t residueFactorial(uint64_t a) const {
+        if (a <= limit()) return factorials[a];
+        uint64_t result = factorials[limit()];
+        for (uint64_t i = limit() + 1; i <= a; i++) result = reducer.multiply(result, i);
+        return result;
+    }
+    
+    // C(n, r) for r <= n <= limit
+    uint64_t smallBinomial(uint64_t n, uint64_t r) const {
+        if (r > n) return 0;
+        return reducer.multiply(reducer.multiply(factorials[n], inverseFactorials[r]), inverseFactorials[n - r]);
+    }
+    
+    // C(n, r) for r <= n < p. Past the table, one pass from limit! up to n!
+    // picks up r! and (n-r)! on the way, then one Fermat inverse divides them
+    // out: n - limit multiplications and an exponentiation in all.
+    uint64_t residueBinomial(uint64_t n, uint64_t r) const {
+        if (n <= limit()) return smallBinomial(n, r);
+        if (r > n) return 0;
+        uint64_t rFactorial = r <= limit() ? factorials[r] : 0;
+        uint64_t restFactorial = n - r <= limit() ? factorials[n - r] : 0;
+        uint64_t result = factorials[limit()];
+        for (uint64_t i = limit() + 1; i <= n; i++) {
+            result = reducer.multiply(result, i);
+            if (i == r) rFactorial = result;
+            if (i == n - r) restFactorial = result;
+        }
+        uint64_t denominator = reducer.multiply(rFactorial, restFactorial);
+        return reducer.multiply(result, powerMod(denominator, p - 2, p));
+    }
+};
+
+} // namespace number_elite
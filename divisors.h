@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <memory_resource>
+#include <utility>
+#include <algorithm>
+#include "multiplicative-functions.h"
+#include "smallest-prime-factor.h"
+#include "pollard-rho.h"
+
+namespace number_elite {
+
+// Function to count number of divisors of a number
+template <typename T>
+constexpr T countDivisors(T n) {
+    T count = 0;
+    for (T i = 1; i <= n / i; i++) {
+        if (n % i == 0) {
+            if (n / i == i) {
+                count++; // Perfect square case
+            } else {
+                count += 2; // Both i and n/i are divisors
+            }
+        }
+    }
+    return count;
+}
+
+// Optimized version using prime factorization
+template <typename T>
+constexpr T countDivisorsOptimized(T n) {
+    if (n < 1) return 0;
+    T count = 1;
+    
+    // Count factors of 2
+    T power = 0;
+    while (n % 2 == 0) {
+        power++;
+        n /= 2;
+    }
+    count *= (power + 1);
+    
+    // Count odd factors
+    for (T i = 3; i <= n / i; i += 2) {
+        power = 0;
+        while (n % i == 0) {
+            power++;
+            n /= i;
+        }
+        count *= (power + 1);
+    }
+    
+    // If n is still > 1, then it's a prime
+    if (n > 1) {
+        count *= 2;
+    }
+    
+    return count;
+}
+
+// Prime factorization of a 64-bit number held inline: no number below 2^64
+// has more than 15 distinct prime factors (the first 16 primes multiply to
+// more than 2^64), so the divisor routines below never allocate for it
+struct Factorization64 {
+    uint64_t prime[15];
+    uint8_t exponent[15];
+    int count = 0;
+    
+    void add(uint64_t p, int e) {
+        prime[count] = p;
+        exponent[count++] = e;
+    }
+};
+
+// Factorization of any n >= 1 by Pollard-Rho, primes increasing, without
+// allocating
+inline Factorization64 factorization64(uint64_t n) {
+    Factorization64 result;
+    forEachPrimeFactor(n, [&](uint64_t p, int e) { result.add(p, e); });
+    return result;
+}
+
+// Factorization of 1 <= n <= table.maxValue() from a smallest-prime-factor
+// table, without allocating
+inline Factorization64 factorization64(const SmallestPrimeFactorTable& table, uint32_t n) {
+    Factorization64 result;
+    table.forEachPrimeFactor(n, [&](uint32_t p, int e) { result.add(p, e); });
+    return result;
+}
+
+// d(n), the number of divisors; at most 103680 for n < 2^64
+inline uint64_t divisorCount(const Factorization64& f) {
+    uint64_t count = 1;
+    for (int i = 0; i < f.count; i++) count *= f.exponent[i] + 1;
+    return count;
+}
+
+// sigma_k(n), the sum of the k-th powers of the divisors, as the product of
+// 1 + p^k + ... + p^(ek) over the prime powers; k = 0 gives d(n). Values that
+// do not fit in 64 bits are returned mod 2^64.
+inline uint64_t divisorSigma(const Factorization64& f, int k) {
+    uint64_t sigma = 1;
+    for (int i = 0; i < f.count; i++) {
+        uint64_t pk = 1;
+        for (int j = 0; j < k; j++) pk *= f.prime[i];
+        uint64_t term = 1, power = 1;
+        for (int j = 0; j < f.exponent[i]; j++) term += power *= pk;
+        sigma *= term;
+    }
+    return sigma;
+}
+
+// Calls visit(d) for every divisor d of n, in no particular order, keeping
+// only a mixed-radix counter over the exponents: product[i] is the part of
+// the current divisor made of primes i and up, so bumping exponent i costs
+// one multiplication and resets the products below it
+template <typename Visitor>
+void forEachDivisor(const Factorization64& f, Visitor visit) {
+    uint64_t product[16];
+    int used[15] = {};
+    for (int i = 0; i <= f.count; i++) product[i] = 1;
+    visit((uint64_t)1);
+    while (true) {
+        int i = 0;
+        while (i < f.count && used[i] == f.exponent[i]) used[i++] = 0;
+        if (i == f.count) return;
+        used[i]++;
+        product[i] *= f.prime[i];
+        for (int j = 0; j < i; j++) product[j] = product[i];
+        visit(product[0]);
+    }
+}
+
+// Writes the divisors of n to out, which must hold divisorCount(f) values,
+// and returns how many were written. Each prime power extends the list so
+// far by its multiples, one multiplication per divisor; the order is
+// unsorted.
+inline size_t divisorsInto(const Factorization64& f, uint64_t* out) {
+    size_t size = 1;
+    out[0] = 1;
+    for (int i = 0; i < f.count; i++) {
+        size_t block = size;
+        for (int j = 0; j < f.exponent[i]; j++) {
+            for (size_t k = 0; k < block; k++) out[size + k] = out[size - block + k] * f.prime[i];
+            size += block;
+        }
+    }
+    return size;
+}
+
+// As divisorsInto, but in increasing order. With A the sorted divisors of
+// the part of n seen so far, adding p^e means merging A, pA, ..., p^e A;
+// each p^j A is merged into the sorted front of out from the back, reading
+// A from scratch, so nothing moves twice and no sort is needed. scratch
+// must hold divisorCount(f) / 2 values.
+inline size_t sortedDivisorsInto(const Factorization64& f, uint64_t* out, uint64_t* scratch) {
+    size_t size = 1;
+    out[0] = 1;
+    for (int i = 0; i < f.count; i++) {
+        size_t block = size;
+        std::copy(out, out + block, scratch);
+        uint64_t power = 1;
+        for (int j = 0; j < f.exponent[i]; j++) {
+            power *= f.prime[i];
+            // Merge out[0, size) with power * scratch[0, block) into out[0, size + block)
+            size_t a = size, b = block, w = size + block;
+            while (b > 0) {
+                uint64_t next = power * scratch[b - 1];
+                uint64_t last = a > 0 ? out[a - 1] : 0;
+                bool fromOut = last > next;
+                out[--w] = fromOut ? last : next;
+                a -= fromOut;
+                b -= !fromOut;
+            }
+            size += block;
+        }
+    }
+    return size;
+}
+
+// All divisors of n >= 1 in increasing order
+inline std::vector<uint64_t> sortedDivisors(uint64_t n) {
+    Factorization64 f = factorization64(n);
+    size_t count = divisorCount(f);
+    std::vector<uint64_t> divisors(count + count / 2);
+    divisors.resize(sortedDivisorsInto(f, divisors.data(), divisors.data() + count));
+    return divisors;
+}
+
+// The same with the result and the merge scratch taken from resource
+inline std::pmr::vector<uint64_t> sortedDivisors(uint64_t n, std::pmr::memory_resource* resource) {
+    Factorization64 f = factorization64(n);
+    size_t count = divisorCount(f);
+    std::pmr::vector<uint64_t> divisors(count + count / 2, resource);
+    divisors.resize(sortedDivisorsInto(f, divisors.data(), divisors.data() + count));
+    return divisors;
+}
+
+// Function to find all divisors, in increasing order, from the factorization
+// of n rather than by trial division up to sqrt(n)
+template <typename T>
+std::vector<T> findAllDivisors(T n) {
+    if (n < 1) return {};
+    std::vector<uint64_t> divisors = sortedDivisors(n);
+    return std::vector<T>(divisors.begin(), divisors.end());
+}
+
+// The same with the result and its 64-bit working copy taken from resource
+template <typename T>
+std::pmr::vector<T> findAllDivisors(T n, std::pmr::memory_resource* resource) {
+    if (n < 1) return std::pmr::vector<T>(resource);
+    std::pmr::vector<uint64_t> divisors = sortedDivisors(n, resource);
+    return std::pmr::vector<T>(divisors.begin(), divisors.end(), resource);
+}
+
+// Number in [1, n] with the most divisors, streamed from block divisor-count
+// tables so no per-number trial division is needed
+template <typename T>
+std::pair<T, T> mostDivisorsUpTo(T n) {
+    std::pair<T, T> best = {1, 1};
+    multiplicativeBlocks(1, n, DIVISOR_COUNT, 1 << 16, [&](const MultiplicativeBlock& block) {
+        for (size_t i = 0; i < block.size; i++) {
+            if ((T)block.divisorCount[i] > best.second) {
+                best = {(T)(block.low + i), (T)block.divisorCount[i]};
+            }
+        }
+    });
+    return best;
+}
+
+} // namespace number_elite
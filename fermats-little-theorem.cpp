@@ -1,43 +1,7 @@
 #include <iostream>
-#include <cmath>
+#include "number-theory.h"
 using namespace std;
-
-// Function to calculate (base^exp) % mod using fast exponentiation
-long long fastPower(long long base, long long exp, long long mod) {
-    long long result = 1;
-    base = base % mod;
-    
-    while (exp > 0) {
-        if (exp % 2 == 1) {
-            result = (result * base) % mod;
-        }
-        exp = exp >> 1; // exp = exp / 2
-        base = (base * base) % mod;
-    }
-    
-    return result;
-}
-
-// Function to calculate modular inverse using Fermat's Little Theorem
-// Works only when mod is prime and a is not divisible by mod
-long long modularInverse(long long a, long long mod) {
-    // According to Fermat's Little Theorem: a^(p-1) ≡ 1 (mod p)
-    // Therefore: a^(p-2) ≡ a^(-1) (mod p)
-    return fastPower(a, mod - 2, mod);
-}
-
-// Function to check if a number is prime (simple check)
-bool isPrime(long long n) {
-    if (n <= 1) return false;
-    if (n <= 3) return true;
-    if (n % 2 == 0 || n % 3 == 0) return false;
-    
-    for (long long i = 5; i * i <= n; i += 6) {
-        if (n % i == 0 || n % (i + 2) == 0)
-            return false;
-    }
-    return true;
-}
+using namespace number_elite;
 
 // Function to verify Fermat's Little Theorem
 bool verifyFermatsLittleTheorem(long long a, long long p) {
@@ -82,7 +46,7 @@ int main() {
         cout << "Modular inverse of " << a << " mod " << p << " = " << inverse << endl;
         
         // Verify inverse
-        long long verification = (a * inverse) % p;
+        long long verification = mulMod((a % p + p) % p, inverse, p);
         cout << "Verification: " << a << " * " << inverse << " mod " << p << " = " << verification << endl;
         
     } else {
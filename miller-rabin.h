@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include "modular-arithmetic.h"
+#include "small-primes.h"
+
+namespace number_elite {
+
+// Deterministic Miller-Rabin primality test for every 64-bit n.
+// n below 2^16 is read from the compile-time bitmap. Larger n go through
+// trial division by the primes below 59; survivors are checked
+// with bases {2, 7, 61} below 2^32 and Jim Sinclair's seven bases above,
+// both of which are proven to have no strong pseudoprimes in their range.
+constexpr bool isPrimeMillerRabin(uint64_t n) {
+    if (n < SMALL_PRIME_LIMIT) return isSmallPrime(n);
+    for (int i = 0; i < 16; i++) {
+        if (n % SMALL_PRIMES.primes[i] == 0) return false;
+    }
+    
+    const uint64_t bases32[] = {2, 7, 61};
+    const uint64_t bases64[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    const uint64_t* bases = n < (1ULL << 32) ? bases32 : bases64;
+    int baseCount = n < (1ULL << 32) ? 3 : 7;
+    
+    Montgomery64 m(n);
+    uint64_t one = m.r, minusOne = n - m.r;
+    uint64_t d = n - 1;
+    int s = __builtin_ctzll(d);
+    d >>= s;
+    
+    for (int i = 0; i < baseCount; i++) {
+        uint64_t a = bases[i] % n;
+        if (a == 0) continue;
+        
+        uint64_t x = m.power(m.toMontgomery(a), d);
+        if (x == one || x == minusOne) continue;
+        
+        bool witness = true;
+        for (int j = 1; j < s && witness; j++) {
+            x = m.multiply(x, x);
+            if (x == minusOne) witness = false;
+        }
+        if (witness) return false;
+    }
+    
+    return true;
+}
+
+} // namespace number_elite
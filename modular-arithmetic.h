@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace number_elite {
+
+// Three interchangeable reducers for 64-bit modular arithmetic:
+//   DivisionReducer - plain 128-bit product and hardware 128/64 division
+//   Barrett64       - division replaced by a multiply with a precomputed 2^128 / n
+//   Montgomery64    - values kept in Montgomery form, odd moduli only
+// Each exposes toForm/fromForm/multiply/one so powerModWith can run on any of them.
+
+// a * b mod n without overflow for any 64-bit operands
+constexpr uint64_t mulMod(uint64_t a, uint64_t b, uint64_t n) {
+    return (unsigned __int128)a * b % n;
+}
+
+struct DivisionReducer {
+    uint64_t n;
+    
+    constexpr explicit DivisionReducer(uint64_t n) : n(n) {}
+    
+    constexpr uint64_t toForm(uint64_t a) const { return a % n; }
+    constexpr uint64_t fromForm(uint64_t a) const { return a; }
+    constexpr uint64_t one() const { return 1 % n; }
+    constexpr uint64_t multiply(uint64_t a, uint64_t b) const { return mulMod(a, b, n); }
+};
+
+// Barrett reduction for any modulus n >= 2: the quotient of a 128-bit product
+// by n is estimated from the high half of its product with mu = 2^128 / n and
+// corrected with a few subtractions
+struct Barrett64 {
+    uint64_t n;
+    uint64_t muHigh = 0, muLow = 0;
+    
+    constexpr explicit Barrett64(uint64_t n) : n(n) {
+        // 2^128 / n, computed as (2^128 - 1) / n with the exact-division case fixed up
+        unsigned __int128 mu = ~(unsigned __int128)0 / n;
+        if (~(unsigned __int128)0 % n == n - 1) mu++;
+        muHigh = mu >> 64;
+        muLow = (uint64_t)mu;
+    }
+    
+    constexpr uint64_t reduce(unsigned __int128 x) const {
+        // Dropping the carries out of the low 64 bits leaves the estimate at most
+        // 5 below the true quotient
+        uint64_t xHigh = x >> 64, xLow = (uint64_t)x;
+        unsigned __int128 quotient = (unsigned __int128)xHigh * muHigh +
+                                     ((unsigned __int128)xHigh * muLow >> 64) +
+                                     ((unsigned __int128)xLow * muHigh >> 64);
+        unsigned __int128 remainder = x - quotient * n;
+        while (remainder >= n) remainder -= n;
+        return remainder;
+    }
+    
+    constexpr uint64_t toForm(uint64_t a) const { return a % n; }
+    constexpr uint64_t fromForm(uint64_t a) const { return a; }
+    constexpr uint64_t one() const { return 1 % n; }
+    constexpr uint64_t multiply(uint64_t a, uint64_t b) const { return reduce((unsigned __int128)a * b); }
+};
+
+// Montgomery form for an odd 64-bit modulus n: a value a is stored as
+// a * 2^64 mod n, which turns every modular multiplication into two 64x64
+// multiplies and a subtraction instead of a 128-bit division.
+struct Montgomery64 {
+    uint64_t n;
+    uint64_t nInverse = 0;   // n^-1 mod 2^64
+    uint64_t r = 0;          // 2^64 mod n, the Montgomery form of 1
+    uint64_t r2 = 0;         // 2^128 mod n, used to convert into Montgomery form
+    
+    constexpr explicit Montgomery64(uint64_t n) : n(n) {
+        // Newton iteration doubles the correct low bits each step: 5 -> 10 -> ... -> 64+
+        nInverse = n;
+        for (int i = 0; i < 5; i++) nInverse *= 2 - n * nInverse;
+        r = -n % n;
+        r2 = (unsigned __int128)r * r % n;
+    }
+    
+    // t * 2^-64 mod n for t < n * 2^64
+    constexpr uint64_t reduce(unsigned __int128 t) const {
+        uint64_t m = (uint64_t)t * nInverse;
+        uint64_t high = t >> 64;
+        uint64_t correction = ((unsigned __int128)m * n) >> 64;
+        return high >= correction ? high - correction : high - correction + n;
+    }
+    
+    constexpr uint64_t toMontgomery(uint64_t a) const { return reduce((unsigned __int128)(a % n) * r2); }
+    constexpr uint64_t fromMontgomery(uint64_t a) const { return reduce(a); }
+    constexpr uint64_t multiply(uint64_t a, uint64_t b) const { return reduce((unsigned __int128)a * b); }
+    
+    constexpr uint64_t toForm(uint64_t a) const { return toMontgomery(a); }
+    constexpr uint64_t fromForm(uint64_t a) const { return fromMontgomery(a); }
+    constexpr uint64_t one() const { return r; }
+    
+    // base^exp with base and result in Montgomery form
+    constexpr uint64_t power(uint64_t base, uint64_t exp) const {
+        uint64_t result = r;
+        while (exp > 0) {
+            if (exp & 1) result = multiply(result, base);
+            base = multiply(base, base);
+            exp >>= 1;
+        }
+        return result;
+    }
+};
+
+// (base^exp) % n on any reducer; build the reducer once and reuse it when
+// many exponentiations share a modulus
+template <typename Reducer>
+constexpr uint64_t powerModWith(const Reducer& reducer, uint64_t base, uint64_t exp) {
+    uint64_t result = reducer.one();
+    base = reducer.toForm(base);
+    while (exp > 0) {
+        if (exp & 1) result = reducer.multiply(result, base);
+        base = reducer.multiply(base, base);
+        exp >>= 1;
+    }
+    return reducer.fromForm(result);
+}
+
+// (base^exp) % mod for an odd modulus, computed in Montgomery form
+constexpr uint64_t montgomeryPowerMod(uint64_t base, uint64_t exp, uint64_t mod) {
+    return powerModWith(Montgomery64(mod), base, exp);
+}
+
+// (base^exp) % mod for any 64-bit modulus: Montgomery for odd moduli, which
+// covers every prime but 2, and 128-bit division otherwise
+constexpr uint64_t powerMod(uint64_t base, uint64_t exp, uint64_t mod) {
+    if (mod == 1) return 0;
+    if (mod & 1) return montgomeryPowerMod(base, exp, mod);
+    return powerModWith(DivisionReducer(mod), base, exp);
+}
+
+// gcd(a, b) by Stein's binary algorithm: shifts by the trailing zero count
+// and subtractions replace the division of every Euclidean step
+constexpr uint64_t binaryGcd(uint64_t a, uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int aZeros = __builtin_ctzll(a);
+    int shift = __builtin_ctzll(a | b);
+    b >>= __builtin_ctzll(b);
+    // The next shift is taken from the raw difference, so the ctz overlaps
+    // the compare instead of waiting on it; the top bit keeps the ctz defined
+    // on the final zero difference
+    while (a != 0) {
+        a >>= aZeros;
+        uint64_t difference = b - a;
+        aZeros = __builtin_ctzll(difference | 1ull << 63);
+        uint64_t smaller = a < b ? a : b;
+        a = a < b ? difference : a - b;
+        b = smaller;
+    }
+    return b << shift;
+}
+
+// Inverse of a modulo mod by the extended Euclidean algorithm, for any 64-bit
+// modulus; returns false when gcd(a, mod) != 1
+constexpr bool inverseMod(uint64_t a, uint64_t mod, uint64_t& inverse) {
+    if (mod == 0) return false;
+    // Invariant: oldR = oldS * a and r = s * a (mod mod), with the coefficients
+    // kept reduced in [0, mod) so nothing overflows
+    uint64_t oldR = a % mod, r = mod;
+    uint64_t oldS = 1 % mod, s = 0;
+    while (r != 0) {
+        uint64_t q = oldR / r;
+        uint64_t nextR = oldR - q * r;
+        uint64_t qs = mulMod(q % mod, s, mod);
+        uint64_t nextS = oldS >= qs ? oldS - qs : oldS + (mod - qs);
+        oldR = r;
+        r = nextR;
+        oldS = s;
+        s = nextS;
+    }
+    if (oldR != 1) return false;
+    inverse = oldS;
+    return true;
+}
+
+// Inverts values[0..count) modulo mod into inverses with Montgomery's trick:
+// prefix products, one extended GCD for the inverse of the total, then a
+// backward sweep peeling off one value at a time - 3 multiplications per
+// value instead of an inversion each. inverses must not alias values. Returns
+// false, leaving inverses unspecified, if any value shares a factor with mod.
+template <typename Reducer>
+bool batchInverseWith(const Reducer& reducer, const uint64_t* values, size_t count, uint64_t* inverses) {
+    if (count == 0) return true;
+    
+    // inverses[i] = values[0] * ... * values[i], in the reducer's form
+    uint64_t product = reducer.one();
+    for (size_t i = 0; i < count; i++) {
+        product = reducer.multiply(product, reducer.toForm(values[i]));
+        inverses[i] = product;
+    }
+    
+    uint64_t inverse = 0;
+    if (!inverseMod(reducer.fromForm(product), reducer.n, inverse)) return false;
+    
+    // inverse holds (values[0] * ... * values[i])^-1 at step i
+    inverse = reducer.toForm(inverse);
+    for (size_t i = count - 1; i > 0; i--) {
+        uint64_t value = reducer.toForm(values[i]);
+        inverses[i] = reducer.fromForm(reducer.multiply(inverse, inverses[i - 1]));
+        inverse = reducer.multiply(inverse, value);
+    }
+    inverses[0] = reducer.fromForm(inverse);
+    return true;
+}
+
+// Batch inversion for any modulus >= 2: Montgomery form for odd moduli, which
+// covers every prime but 2, and 128-bit division otherwise
+inline bool batchModularInverse(const uint64_t* values, size_t count, uint64_t mod, uint64_t* inverses) {
+    if (mod & 1) return batchInverseWith(Montgomery64(mod), values, count, inverses);
+    return batchInverseWith(DivisionReducer(mod), values, count, inverses);
+}
+
+} // namespace number_elite
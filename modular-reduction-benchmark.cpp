@@ -0,0 +1,54 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include "modular-arithmetic.h"
+using namespace std;
+using namespace number_elite;
+
+// Times powerModWith on each reducer for a batch of random (base, exponent) pairs
+// sharing one modulus, the case where building the reducer once pays off
+template <typename Reducer>
+double nanosecondsPerPower(const Reducer& reducer, const vector<uint64_t>& bases,
+                           const vector<uint64_t>& exponents, uint64_t& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < bases.size(); i++) {
+        checksum += powerModWith(reducer, bases[i], exponents[i]);
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    return chrono::duration<double, nano>(elapsed).count() / bases.size();
+}
+
+int main() {
+    const int POWERS = 200000;
+    mt19937_64 rng(2024);
+    
+    cout << "=== Modular Reduction Benchmark (ns per 64-bit powerMod) ===" << endl;
+    cout << setw(12) << "modulus bits" << setw(14) << "128-bit div" << setw(12) << "Barrett"
+         << setw(14) << "Montgomery" << endl;
+    
+    for (int bits : {16, 31, 32, 48, 62, 63, 64}) {
+        // Odd moduli so that all three strategies apply
+        uint64_t mod = (bits == 64 ? rng() : rng() >> (64 - bits)) | 1 | (1ULL << (bits - 1));
+        
+        vector<uint64_t> bases(POWERS), exponents(POWERS);
+        for (int i = 0; i < POWERS; i++) {
+            bases[i] = rng();
+            exponents[i] = rng();
+        }
+        
+        uint64_t division = 0, barrett = 0, montgomery = 0;
+        double divisionTime = nanosecondsPerPower(DivisionReducer(mod), bases, exponents, division);
+        double barrettTime = nanosecondsPerPower(Barrett64(mod), bases, exponents, barrett);
+        double montgomeryTime = nanosecondsPerPower(Montgomery64(mod), bases, exponents, montgomery);
+        
+        cout << setw(12) << bits << fixed << setprecision(1) << setw(14) << divisionTime
+             << setw(12) << barrettTime << setw(14) << montgomeryTime;
+        if (division != barrett || barrett != montgomery) cout << "  ✗ results differ!";
+        cout << endl;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+namespace number_elite {
+
+// Selects which functions a batch computes; combine with |
+enum MultiplicativeFunction : unsigned {
+    TOTIENT = 1,        // phi(n)
+    MOBIUS = 2,         // mu(n)
+    DIVISOR_COUNT = 4,  // d(n)
+    DIVISOR_SUM = 8,    // sigma(n)
+    ALL_FUNCTIONS = 15
+};
+
+// Values for every n in [low, low + size); vectors of unselected functions stay empty
+struct MultiplicativeBlock {
+    uint64_t low = 0;
+    size_t size = 0;
+    std::vector<uint64_t> totient;
+    std::vector<int8_t> mobius;
+    std::vector<uint32_t> divisorCount;
+    std::vector<uint64_t> divisorSum;
+};
+
+// Tables of the selected functions for every n in [0, n] in one pass of the
+// linear sieve. Each composite i * p is reached once from its smallest prime p,
+// so every value follows from the value at i. d and sigma also need the
+// exponent of the smallest prime and the sum 1 + p + ... + p^e of its powers.
+// Index 0 holds 0 for every function.
+inline MultiplicativeBlock multiplicativeTables(uint32_t n, unsigned functions = ALL_FUNCTIONS) {
+    MultiplicativeBlock table;
+    table.size = (size_t)n + 1;
+    bool wantPhi = functions & TOTIENT, wantMu = functions & MOBIUS;
+    bool wantD = functions & DIVISOR_COUNT, wantSigma = functions & DIVISOR_SUM;
+    
+    if (wantPhi) table.totient.assign(table.size, 0);
+    if (wantMu) table.mobius.assign(table.size, 0);
+    if (wantD) table.divisorCount.assign(table.size, 0);
+    if (wantSigma) table.divisorSum.assign(table.size, 0);
+    std::vector<uint8_t> smallestExponent(wantD ? table.size : 0);
+    std::vector<uint64_t> smallestPowerSum(wantSigma ? table.size : 0);
+    
+    if (n >= 1) {
+        if (wantPhi) table.totient[1] = 1;
+        if (wantMu) table.mobius[1] = 1;
+        if (wantD) table.divisorCount[1] = 1;
+        if (wantSigma) table.divisorSum[1] = 1;
+    }
+    
+    std::vector<bool> composite(table.size, false);
+    std::vector<uint32_t> primes;
+    for (uint64_t i = 2; i <= n; i++) {
+        if (!composite[i]) {
+            primes.push_back(i);
+            if (wantPhi) table.totient[i] = i - 1;
+            if (wantMu) table.mobius[i] = -1;
+            if (wantD) table.divisorCount[i] = 2, smallestExponent[i] = 1;
+            if (wantSigma) table.divisorSum[i] = i + 1, smallestPowerSum[i] = i + 1;
+        }
+        
+        for (uint64_t p : primes) {
+            uint64_t k = i * p;
+            if (k > n) break;
+            composite[k] = true;
+            
+            if (i % p == 0) {
+                // p already divides i: only the exponent of p grows
+                if (wantPhi) table.totient[k] = table.totient[i] * p;
+                if (wantMu) table.mobius[k] = 0;
+                if (wantD) {
+                    smallestExponent[k] = smallestExponent[i] + 1;
+                    table.divisorCount[k] = table.divisorCount[i] / (smallestExponent[i] + 1) * (smallestExponent[k] + 1);
+                }
+                if (wantSigma) {
+                    smallestPowerSum[k] = smallestPowerSum[i] * p + 1;
+                    table.divisorSum[k] = table.divisorSum[i] / smallestPowerSum[i] * smallestPowerSum[k];
+                }
+                break;
+            }
+            
+            // p is a new, smaller prime factor: multiply in f(p)
+            if (wantPhi) table.totient[k] = table.totient[i] * (p - 1);
+            if (wantMu) table.mobius[k] = -table.mobius[i];
+            if (wantD) table.divisorCount[k] = table.divisorCount[i] * 2, smallestExponent[k] = 1;
+            if (wantSigma) table.divisorSum[k] = table.divisorSum[i] * (p + 1), smallestPowerSum[k] = p + 1;
+        }
+    }
+    
+    return table;
+}
+
+// Segmented mode: calls visit(block) for consecutive blocks covering [lo, hi],
+// reusing one block of blockSize values so memory stays O(blockSize + sqrt(hi))
+// however large the range. Each block divides the primes up to sqrt(hi) out of
+// its numbers; whatever remains above 1 is a single large prime factor.
+template <typename Visitor>
+void multiplicativeBlocks(uint64_t lo, uint64_t hi, unsigned functions, size_t blockSize, Visitor visit) {
+    lo = std::max<uint64_t>(lo, 1);
+    if (hi < lo) return;
+    bool wantPhi = functions & TOTIENT, wantMu = functions & MOBIUS;
+    bool wantD = functions & DIVISOR_COUNT, wantSigma = functions & DIVISOR_SUM;
+    
+    uint64_t root = std::sqrt((double)hi);
+    while (root * root > hi) root--;
+    while ((root + 1) * (root + 1) <= hi) root++;
+    std::vector<bool> composite(root + 1, false);
+    std::vector<uint64_t> primes;
+    for (uint64_t i = 2; i <= root; i++) {
+        if (composite[i]) continue;
+        primes.push_back(i);
+        for (uint64_t j = i * i; j <= root; j += i) composite[j] = true;
+    }
+    
+    MultiplicativeBlock block;
+    std::vector<uint64_t> remaining;
+    for (uint64_t low = lo;; low += blockSize) {
+        uint64_t high = std::min<uint64_t>(hi, low + blockSize - 1);
+        block.low = low;
+        block.size = high - low + 1;
+        remaining.resize(block.size);
+        for (size_t i = 0; i < block.size; i++) remaining[i] = low + i;
+        if (wantPhi) block.totient.assign(remaining.begin(), remaining.end());
+        if (wantMu) block.mobius.assign(block.size, 1);
+        if (wantD) block.divisorCount.assign(block.size, 1);
+        if (wantSigma) block.divisorSum.assign(block.size, 1);
+        
+        for (uint64_t p : primes) {
+            for (uint64_t m = (low + p - 1) / p * p; m <= high; m += p) {
+                size_t i = m - low;
+                uint64_t power = 1, powerSum = 1;
+                int e = 0;
+                do {
+                    remaining[i] /= p;
+                    power *= p;
+                    powerSum += power;
+                    e++;
+                } while (remaining[i] % p == 0);
+                
+                if (wantPhi) block.totient[i] = block.totient[i] / p * (p - 1);
+                if (wantMu) block.mobius[i] = e > 1 ? 0 : -block.mobius[i];
+                if (wantD) block.divisorCount[i] *= e + 1;
+                if (wantSigma) block.divisorSum[i] *= powerSum;
+            }
+        }
+        
+        for (size_t i = 0; i < block.size; i++) {
+            uint64_t q = remaining[i];
+            if (q == 1) continue;
+            if (wantPhi) block.totient[i] = block.totient[i] / q * (q - 1);
+            if (wantMu) block.mobius[i] = -block.mobius[i];
+            if (wantD) block.divisorCount[i] *= 2;
+            if (wantSigma) block.divisorSum[i] *= q + 1;
+        }
+        
+        visit(static_cast<const MultiplicativeBlock&>(block));
+        if (high == hi) break;
+    }
+}
+
+} // namespace number_elite
@@ -0,0 +1,735 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unistd.h>
+#include "number-elite.h"
+using namespace std;
+using namespace number_elite;
+
+// ---- Buffered I/O ----
+
+// Reads newline-delimited queries of unsigned integers through a large read
+// buffer instead of formatted cin extraction. read returns whatever a pipe
+// holds, so a line is answered as soon as it arrives.
+class FastReader {
+public:
+    explicit FastReader(FILE* file) : file(file), buffer(1 << 16) {}
+    
+    // Parses the next non-blank line into numbers, after a leading word of
+    // letters when word is given. Returns false at end of input; valid is
+    // cleared if the line held anything else but blanks or a number that
+    // does not fit in 64 bits.
+    bool readLine(vector<uint64_t>& numbers, bool& valid, string* word = nullptr) {
+        numbers.clear();
+        valid = true;
+        int c;
+        while ((c = get()) != EOF && isspace(c)) {}
+        if (c == EOF) return false;
+        
+        if (word) {
+            word->clear();
+            while (isalpha(c)) {
+                *word += (char)c;
+                c = get();
+            }
+        }
+        while (c != EOF && c != '\n') {
+            if (c >= '0' && c <= '9') {
+                uint64_t value = 0;
+                while (c >= '0' && c <= '9') {
+                    uint64_t digit = c - '0';
+                    if (value > (UINT64_MAX - digit) / 10) valid = false;
+                    value = value * 10 + digit;
+                    c = get();
+                }
+                numbers.push_back(value);
+            } else {
+                if (!isspace(c)) valid = false;
+                c = get();
+            }
+        }
+        return true;
+    }
+    
+private:
+    FILE* file;
+    vector<char> buffer;
+    size_t position = 0, length = 0;
+    
+    int get() {
+        if (position == length) {
+            ssize_t bytes;
+            do {
+                bytes = read(fileno(file), buffer.data(), buffer.size());
+            } while (bytes < 0 && errno == EINTR);
+            position = 0;
+            length = bytes > 0 ? bytes : 0;
+            if (length == 0) return EOF;
+        }
+        return (unsigned char)buffer[position++];
+    }
+};
+
+// Collects output in a large buffer and writes it with fwrite, so a query
+// costs a few stores rather than a flushed stream insertion. Without a file
+// the buffer grows instead and holds everything written until clear().
+class FastWriter {
+public:
+    explicit FastWriter(FILE* file = stdout) : file(file), buffer(1 << 16) {}
+    ~FastWriter() { flush(); }
+    
+    FastWriter& operator<<(uint64_t value) {
+        char digits[20];
+        int count = 0;
+        do {
+            digits[count++] = '0' + value % 10;
+            value /= 10;
+        } while (value > 0);
+        reserve(count);
+        while (count > 0) buffer[length++] = digits[--count];
+        return *this;
+    }
+    
+    FastWriter& operator<<(char c) {
+        reserve(1);
+        buffer[length++] = c;
+        return *this;
+    }
+    
+    FastWriter& operator<<(const char* text) {
+        size_t size = strlen(text);
+        reserve(size);
+        memcpy(buffer.data() + length, text, size);
+        length += size;
+        return *this;
+    }
+    
+    FastWriter& operator<<(const string& text) {
+        reserve(text.size());
+        memcpy(buffer.data() + length, text.data(), text.size());
+        length += text.size();
+        return *this;
+    }
+    
+    void flush() {
+        if (!file) return;
+        fwrite(buffer.data(), 1, length, file);
+        fflush(file);
+        length = 0;
+    }
+    
+    // What an in-memory writer holds
+    const char* data() const { return buffer.data(); }
+    size_t size() const { return length; }
+    void clear() { length = 0; }
+    
+private:
+    FILE* file;
+    vector<char> buffer;
+    size_t length = 0;
+    
+    void reserve(size_t size) {
+        if (length + size <= buffer.size()) return;
+        if (file) {
+            fwrite(buffer.data(), 1, length, file);
+            length = 0;
+            if (size > buffer.size()) buffer.resize(size);
+        } else {
+            buffer.resize(max(2 * buffer.size(), length + size));
+        }
+    }
+};
+
+// ---- Commands ----
+
+// Prime index given with -i; queries at or below its limit are answered from
+// the mapped file instead of being sieved or tested
+PrimeIndex primeIndex;
+
+bool indexCovers(uint64_t x) {
+    return primeIndex.isOpen() && x <= primeIndex.limit();
+}
+
+// Shared prime cache of serve and loadtest, grown by the queries themselves;
+// isprime, count, factor, totient and divisors use it when it covers the query
+PrimeCache* primeCache = nullptr;
+
+bool cacheCovers(uint64_t x) {
+    return primeCache && primeCache->tryCover(x);
+}
+
+// Threads for one pi(x); the server's workers each count with one
+unsigned countThreads = 0;
+
+// Calls visit(p, e) for the prime factorization of n, p increasing
+template <typename Visitor>
+void forEachFactor(uint64_t n, Visitor visit) {
+    if (cacheCovers(n)) {
+        primeCache->forEachPrimeFactor(n, visit);
+    } else {
+        forEachPrimeFactor(n, visit);
+    }
+}
+
+// A subcommand answers one query of between minArgs and maxArgs numbers and
+// writes exactly one output line (sieve writes one line per prime)
+struct Command {
+    const char* name;
+    int minArgs, maxArgs;
+    const char* arguments;
+    const char* description;
+    void (*run)(const vector<uint64_t>& args, FastWriter& out);
+};
+
+// [lo, hi] from either "hi" or "lo hi"
+void queryRange(const vector<uint64_t>& args, uint64_t& lo, uint64_t& hi) {
+    lo = args.size() == 2 ? args[0] : 0;
+    hi = args.back();
+}
+
+void runSieve(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t lo, hi;
+    queryRange(args, lo, hi);
+    sieveRange(lo, hi, [&](uint64_t p) { out << p << '\n'; });
+}
+
+// Widest [lo, hi] that is cheaper to sieve than to count with pi(x): pi(x)
+// costs about x^(2/3) whatever the window, sieving about hi - lo. pi(x) is only
+// valid below 2^63, so windows above that are always sieved.
+uint64_t countSieveWindow(uint64_t hi) {
+    double root = cbrt((double)hi);
+    return root * root;
+}
+
+void runCount(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t lo, hi;
+    queryRange(args, lo, hi);
+    if (lo > hi) {
+        out << (uint64_t)0 << '\n';
+    } else if (indexCovers(hi)) {
+        out << primeIndex.rank(hi) - (lo > 0 ? primeIndex.rank(lo - 1) : 0) << '\n';
+    } else if (cacheCovers(hi)) {
+        out << primeCache->primeCount(hi) - (lo > 0 ? primeCache->primeCount(lo - 1) : 0) << '\n';
+    } else if (hi < (1ull << 63) && hi - lo >= countSieveWindow(hi)) {
+        out << primeCount(hi, countThreads) - (lo > 0 ? primeCount(lo - 1, countThreads) : 0) << '\n';
+    } else {
+        uint64_t count = 0;
+        sieveRange(lo, hi, [&](uint64_t) { count++; });
+        out << count << '\n';
+    }
+}
+
+// Same layout as coreutils factor: "n: p p p ..."
+void runFactor(const vector<uint64_t>& args, FastWriter& out) {
+    out << args[0] << ':';
+    forEachFactor(args[0], [&](uint64_t p, int e) {
+        for (int i = 0; i < e; i++) out << ' ' << p;
+    });
+    out << '\n';
+}
+
+void runTotient(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t n = args[0], result = n;
+    forEachFactor(n, [&](uint64_t p, int) { result -= result / p; });
+    out << result << '\n';
+}
+
+// Number of divisors followed by their sum, which may need more than 64 bits
+void runDivisors(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t count = args[0] > 0;
+    unsigned __int128 sum = args[0] > 0;
+    forEachFactor(args[0], [&](uint64_t p, int e) {
+        unsigned __int128 power = 1, powerSum = 1;
+        for (int i = 0; i < e; i++) {
+            power *= p;
+            powerSum += power;
+        }
+        count *= e + 1;
+        sum *= powerSum;
+    });
+    
+    out << count << ' ';
+    if (sum >> 64) {
+        // Split into two base-10^19 digits
+        const uint64_t BASE = 10000000000000000000ull;
+        char low[21];
+        snprintf(low, sizeof(low), "%019llu", (unsigned long long)(sum % BASE));
+        out << (uint64_t)(sum / BASE) << low;
+    } else {
+        out << (uint64_t)sum;
+    }
+    out << '\n';
+}
+
+void runPowmod(const vector<uint64_t>& args, FastWriter& out) {
+    if (args[2] == 0) {
+        out << "error: modulus must be positive\n";
+        return;
+    }
+    out << powerMod(args[0], args[1], args[2]) << '\n';
+}
+
+void runIsPrime(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t n = args[0];
+    bool prime = indexCovers(n) ? primeIndex.isPrime(n) : cacheCovers(n) ? primeCache->isPrime(n) : isPrimeMillerRabin(n);
+    out << (prime ? "1\n" : "0\n");
+}
+
+// select on the index when it holds k primes, otherwise pi(x) and a local sieve
+void runNth(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t k = args[0];
+    uint64_t p = primeIndex.isOpen() && k <= primeIndex.primeCount() ? primeIndex.select(k) : nthPrime(k);
+    if (p != 0) {
+        out << p << '\n';
+    } else {
+        out << "none\n";
+    }
+}
+
+// Outside the index, prime gaps below 2^64 are short enough to step through
+// the odd numbers with Miller-Rabin
+void runNext(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t n = args[0], p = 0;
+    if (indexCovers(n) && (p = primeIndex.nextPrime(n)) != 0) {
+        out << p << '\n';
+        return;
+    }
+    if (n <= 2) {
+        out << "2\n";
+        return;
+    }
+    for (p = n | 1; p >= n; p += 2) {
+        if (isPrimeMillerRabin(p)) {
+            out << p << '\n';
+            return;
+        }
+    }
+    out << "none\n";
+}
+
+void runPrev(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t n = args[0];
+    if (indexCovers(n)) {
+        uint64_t p = primeIndex.prevPrime(n);
+        if (p != 0) {
+            out << p << '\n';
+        } else {
+            out << "none\n";
+        }
+        return;
+    }
+    if (n < 2) {
+        out << "none\n";
+        return;
+    }
+    if (n == 2) {
+        out << "2\n";
+        return;
+    }
+    for (uint64_t p = (n - 1) | 1; p >= 3; p -= 2) {
+        if (isPrimeMillerRabin(p)) {
+            out << p << '\n';
+            return;
+        }
+    }
+}
+
+void runInverse(const vector<uint64_t>& args, FastWriter& out) {
+    uint64_t inverse;
+    if (inverseMod(args[0], args[1], inverse)) {
+        out << inverse << '\n';
+    } else {
+        out << "none\n";
+    }
+}
+
+const Command COMMANDS[] = {
+    {"sieve", 1, 2, "[lo] hi", "primes in [lo, hi], one per line", runSieve},
+    {"count", 1, 2, "[lo] hi", "number of primes in [lo, hi]", runCount},
+    {"factor", 1, 1, "n", "prime factors of n, with multiplicity", runFactor},
+    {"totient", 1, 1, "n", "Euler's totient of n", runTotient},
+    {"divisors", 1, 1, "n", "number and sum of the divisors of n", runDivisors},
+    {"powmod", 3, 3, "b e m", "b^e mod m", runPowmod},
+    {"isprime", 1, 1, "n", "1 if n is prime, 0 otherwise", runIsPrime},
+    {"nth", 1, 1, "k", "the k-th prime, nth 1 being 2", runNth},
+    {"next", 1, 1, "n", "smallest prime >= n, or none", runNext},
+    {"prev", 1, 1, "n", "largest prime <= n, or none", runPrev},
+    {"inverse", 2, 2, "a m", "inverse of a mod m, or none", runInverse},
+};
+
+void printUsage(const char* program) {
+    cerr << "usage: " << program << " <command> [numbers...] [-f file] [-i index]" << endl;
+    cerr << "       " << program << " index n file" << endl;
+    cerr << "       " << program << " serve [-t threads] [-c limit] [-i index]" << endl;
+    cerr << "       " << program << " loadtest [-t threads] [-c limit] [-d seconds]" << endl;
+    cerr << "Numbers given as arguments form the queries; otherwise one query per" << endl;
+    cerr << "line is read from the file, or from stdin when no file is given." << endl;
+    cerr << "index writes a prime index of [0, n] to file; -i answers count," << endl;
+    cerr << "isprime, nth, next and prev from such an index when it covers the query." << endl;
+    cerr << "serve answers \"command numbers...\" lines from stdin on a pool of threads," << endl;
+    cerr << "in order, sharing a prime cache below limit (default 2^26) that grows as" << endl;
+    cerr << "queries need it; loadtest runs random queries against that pool and prints" << endl;
+    cerr << "throughput and p50/p99 latency per command." << endl;
+    cerr << endl << "commands:" << endl;
+    for (const Command& command : COMMANDS) {
+        string synopsis = string(command.name) + " " + command.arguments;
+        cerr << "  " << synopsis << string(max<int>(2, 20 - synopsis.size()), ' ') << command.description << endl;
+    }
+}
+
+// Runs one query, or reports it on its output line when it is malformed so
+// answers stay aligned with their input lines
+void answer(const Command& command, const vector<uint64_t>& args, bool valid, FastWriter& out) {
+    if (!valid) {
+        out << "error: queries are unsigned 64-bit integers\n";
+    } else if ((int)args.size() < command.minArgs || (int)args.size() > command.maxArgs) {
+        out << "error: usage: " << command.name << ' ' << command.arguments << '\n';
+    } else {
+        command.run(args, out);
+    }
+}
+
+// ---- Server ----
+
+// One query travelling through the worker pool; done and finished are
+// guarded by the pool's mutex
+struct Job {
+    const Command* command = nullptr;
+    vector<uint64_t> args;
+    bool valid = true;
+    string response;
+    bool done = false;
+    condition_variable finished;
+};
+
+// Fixed set of threads answering jobs in the order they are submitted. Each
+// worker formats into its own in-memory writer and hands the text back in
+// the job.
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threads) {
+        for (unsigned i = 0; i < threads; i++) workers.emplace_back([this] { work(); });
+    }
+    
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (thread& worker : workers) worker.join();
+    }
+    
+    void submit(Job* job) {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            job->done = false;
+            queue.push_back(job);
+        }
+        ready.notify_one();
+    }
+    
+    bool isDone(Job* job) {
+        lock_guard<mutex> lock(queueMutex);
+        return job->done;
+    }
+    
+    void wait(Job* job) {
+        unique_lock<mutex> lock(queueMutex);
+        job->finished.wait(lock, [&] { return job->done; });
+    }
+    
+private:
+    mutex queueMutex;
+    condition_variable ready;
+    deque<Job*> queue;
+    vector<thread> workers;
+    bool stopping = false;
+    
+    void work() {
+        FastWriter out(nullptr);
+        for (;;) {
+            Job* job;
+            {
+                unique_lock<mutex> lock(queueMutex);
+                ready.wait(lock, [&] { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                job = queue.front();
+                queue.pop_front();
+            }
+            
+            out.clear();
+            if (job->command) {
+                answer(*job->command, job->args, job->valid, out);
+            } else {
+                out << "error: unknown command\n";
+            }
+            job->response.assign(out.data(), out.size());
+            
+            lock_guard<mutex> lock(queueMutex);
+            job->done = true;
+            job->finished.notify_one();
+        }
+    }
+};
+
+const Command* findCommand(const string& name) {
+    for (const Command& command : COMMANDS) {
+        if (name == command.name) return &command;
+    }
+    return nullptr;
+}
+
+// Answers "command numbers..." lines from stdin on a pool of workers, writing
+// each answer to stdout in the order of the requests. A reader thread parses
+// and submits while this thread writes; at most MAX_IN_FLIGHT requests wait
+// at once, and output is flushed whenever the next answer is not ready yet,
+// so an interactive client gets every answer without closing its end.
+void serve(unsigned threads) {
+    const size_t MAX_IN_FLIGHT = 1024;
+    WorkerPool pool(threads);
+    mutex pendingMutex;
+    condition_variable changed;
+    deque<unique_ptr<Job>> pending;
+    bool inputClosed = false;
+    
+    thread reader([&] {
+        FastReader in(stdin);
+        string name;
+        for (;;) {
+            unique_ptr<Job> job(new Job());
+            if (!in.readLine(job->args, job->valid, &name)) break;
+            job->command = findCommand(name);
+            Job* submitted = job.get();
+            {
+                unique_lock<mutex> lock(pendingMutex);
+                changed.wait(lock, [&] { return pending.size() < MAX_IN_FLIGHT; });
+                pending.push_back(move(job));
+            }
+            changed.notify_all();
+            pool.submit(submitted);
+        }
+        lock_guard<mutex> lock(pendingMutex);
+        inputClosed = true;
+        changed.notify_all();
+    });
+    
+    FastWriter out;
+    for (;;) {
+        unique_ptr<Job> job;
+        {
+            unique_lock<mutex> lock(pendingMutex);
+            if (pending.empty() && !inputClosed) {
+                lock.unlock();
+                out.flush();
+                lock.lock();
+            }
+            changed.wait(lock, [&] { return !pending.empty() || inputClosed; });
+            if (pending.empty()) break;
+            job = move(pending.front());
+            pending.pop_front();
+        }
+        changed.notify_all();
+        if (!pool.isDone(job.get())) {
+            out.flush();
+            pool.wait(job.get());
+        }
+        out << job->response;
+    }
+    reader.join();
+}
+
+// Closed-loop load generator: each client thread submits one random query to
+// the pool, wait for its answer and submit the next, for the given time.
+// Numbers are log-uniform below 2^64 (pi(x) below 2^32), so the cache is
+// grown by the queries as it would be in service. Prints the throughput and
+// the 50th and 99th percentile latencies per command.
+void loadTest(unsigned threads, double seconds) {
+    const char* NAMES[] = {"isprime", "factor", "totient", "divisors", "count", "powmod"};
+    const int KINDS = sizeof(NAMES) / sizeof(NAMES[0]);
+    unsigned clients = 2 * threads;
+    WorkerPool pool(threads);
+    vector<vector<vector<double>>> latencies(clients, vector<vector<double>>(KINDS));   // [client][kind], microseconds
+    
+    auto deadline = chrono::steady_clock::now() + chrono::duration<double>(seconds);
+    vector<thread> clientThreads;
+    for (unsigned c = 0; c < clients; c++) {
+        clientThreads.emplace_back([&, c] {
+            mt19937_64 generator(c + 1);
+            auto logUniform = [&](int maxBits) { return generator() >> (63 - generator() % maxBits); };
+            Job job;
+            while (chrono::steady_clock::now() < deadline) {
+                int kind = generator() % KINDS;
+                job.command = findCommand(NAMES[kind]);
+                if (kind == 5) {
+                    job.args = {generator(), generator(), logUniform(64) | 1};
+                } else {
+                    job.args.assign(1, logUniform(kind == 4 ? 32 : 64));
+                }
+                
+                auto start = chrono::steady_clock::now();
+                pool.submit(&job);
+                pool.wait(&job);
+                latencies[c][kind].push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+            }
+        });
+    }
+    for (thread& client : clientThreads) client.join();
+    
+    auto percentile = [](vector<double>& values, double fraction) {
+        if (values.empty()) return 0.0;
+        size_t k = min(values.size() - 1, (size_t)(fraction * values.size()));
+        nth_element(values.begin(), values.begin() + k, values.end());
+        return values[k];
+    };
+    
+    printf("%u workers, %u clients, %.1f s, cache limit %llu of %llu (%.1f MiB)\n", threads, clients, seconds,
+           (unsigned long long)primeCache->limit(), (unsigned long long)primeCache->maxLimit(),
+           primeCache->memoryBytes() / 1048576.0);
+    printf("%-10s %12s %12s %12s %12s\n", "command", "queries", "queries/s", "p50 (us)", "p99 (us)");
+    vector<double> all;
+    for (int kind = 0; kind < KINDS; kind++) {
+        vector<double> values;
+        for (unsigned c = 0; c < clients; c++) values.insert(values.end(), latencies[c][kind].begin(), latencies[c][kind].end());
+        all.insert(all.end(), values.begin(), values.end());
+        size_t count = values.size();
+        double p50 = percentile(values, 0.5), p99 = percentile(values, 0.99);
+        printf("%-10s %12zu %12.0f %12.2f %12.2f\n", NAMES[kind], count, count / seconds, p50, p99);
+    }
+    size_t count = all.size();
+    double p50 = percentile(all, 0.5), p99 = percentile(all, 0.99);
+    printf("%-10s %12zu %12.0f %12.2f %12.2f\n", "all", count, count / seconds, p50, p99);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    if (strcmp(argv[1], "index") == 0) {
+        char* end;
+        uint64_t n = argc == 4 ? strtoull(argv[2], &end, 10) : 0;
+        if (argc != 4 || *end != '\0' || argv[2][0] == '-') {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!writePrimeIndex(argv[3], n)) {
+            cerr << "cannot write " << argv[3] << endl;
+            return 1;
+        }
+        return 0;
+    }
+    
+    if (strcmp(argv[1], "serve") == 0 || strcmp(argv[1], "loadtest") == 0) {
+        unsigned threads = defaultThreadCount();
+        uint64_t limit = 1 << 26;
+        double seconds = 5;
+        for (int i = 2; i < argc; i++) {
+            char* end = nullptr;
+            if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+                threads = strtoul(argv[++i], &end, 10);
+            } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+                limit = strtoull(argv[++i], &end, 10);
+            } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+                seconds = strtod(argv[++i], &end);
+            } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+                if (!primeIndex.open(argv[++i])) {
+                    cerr << "not a prime index: " << argv[i] << endl;
+                    return 1;
+                }
+                continue;
+            }
+            if (!end || *end != '\0' || argv[i][0] == '-' || threads == 0 || seconds <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        
+        PrimeCache cache(limit);
+        primeCache = &cache;
+        countThreads = 1;
+        if (strcmp(argv[1], "serve") == 0) {
+            serve(threads);
+        } else {
+            loadTest(threads, seconds);
+        }
+        return 0;
+    }
+    
+    const Command* command = findCommand(argv[1]);
+    if (!command) {
+        cerr << "unknown command: " << argv[1] << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    const char* path = nullptr;
+    vector<uint64_t> args;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            path = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            if (!primeIndex.open(argv[++i])) {
+                cerr << "not a prime index: " << argv[i] << endl;
+                return 1;
+            }
+            continue;
+        }
+        char* end;
+        errno = 0;
+        uint64_t value = strtoull(argv[i], &end, 10);
+        if (*end != '\0' || argv[i][0] == '-' || errno == ERANGE) {
+            cerr << "not an unsigned 64-bit integer: " << argv[i] << endl;
+            return 1;
+        }
+        args.push_back(value);
+    }
+    
+    FastWriter out;
+    
+    // Arguments: sieve and count take a single range, the others group the
+    // numbers into as many queries as they hold
+    if (!args.empty()) {
+        size_t arity = command->maxArgs;
+        if (command->minArgs != command->maxArgs || args.size() % arity != 0) {
+            answer(*command, args, true, out);
+        } else {
+            for (size_t i = 0; i < args.size(); i += arity) {
+                answer(*command, vector<uint64_t>(args.begin() + i, args.begin() + i + arity), true, out);
+            }
+        }
+        return 0;
+    }
+    
+    FILE* file = path ? fopen(path, "r") : stdin;
+    if (!file) {
+        cerr << "cannot open " << path << endl;
+        return 1;
+    }
+    
+    FastReader in(file);
+    bool valid;
+    while (in.readLine(args, valid)) {
+        answer(*command, args, valid, out);
+    }
+    if (path) fclose(file);
+    
+    return 0;
+}
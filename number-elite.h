@@ -0,0 +1,43 @@
+#pragma once
+
+// Header-only number theory library. Everything lives in namespace
+// number_elite; include this header for all of it or the individual headers
+// for just the parts you need.
+//
+//   arena.h                    per-thread arena for allocation-free queries
+//   small-primes.h             compile-time primes and bitmap below 2^16
+//   modular-arithmetic.h       mulMod, reducers, powerMod, binaryGcd, inverses
+//   miller-rabin.h             deterministic 64-bit isPrimeMillerRabin
+//   batch-primality.h          AVX2 primality of many 32-bit values
+//   pollard-rho.h              factorize for any 64-bit n
+//   number-theory.h            gcd, modular inverse, fastPower, totient, ...
+//   trial-division.h           trial-division primality and prime listing
+//   divisors.h                 divisor counting, enumeration and sigma_k
+//   smallest-prime-factor.h    smallest-prime-factor table for bulk queries
+//   multiplicative-functions.h phi, mu, d and sigma tables
+//   combinatorics.h            factorial tables, binomials mod p, Lucas
+//   sieve.h                    sieves (Atkin, mod-210 and mod-30 wheels), PrimeIterator, PrimeBitset, LazySieve
+//   parallel-sieve.h           multithreaded sieve
+//   sieve-backends.h           sieves behind one interface, calibrated dispatch
+//   prime-count.h              pi(x) by Lagarias-Miller-Odlyzko
+//   prime-index.h              memory-mapped on-disk prime index
+//   prime-cache.h              shared smallest-prime-factor cache that grows on demand
+
+#include "arena.h"
+#include "small-primes.h"
+#include "modular-arithmetic.h"
+#include "miller-rabin.h"
+#include "batch-primality.h"
+#include "pollard-rho.h"
+#include "number-theory.h"
+#include "trial-division.h"
+#include "divisors.h"
+#include "smallest-prime-factor.h"
+#include "multiplicative-functions.h"
+#include "combinatorics.h"
+#include "sieve.h"
+#include "parallel-sieve.h"
+#include "sieve-backends.h"
+#include "prime-count.h"
+#include "prime-index.h"
+#include "prime-cache.h"
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <memory_resource>
+#include <utility>
+#include <type_traits>
+#include "modular-arithmetic.h"
+#include "miller-rabin.h"
+#include "pollard-rho.h"
+
+namespace number_elite {
+
+// Classic number theory templated on the integer type T. Everything except
+// primeFactorization is constexpr, so it can run at compile time or be
+// inlined into a caller's loop; products go through the 128-bit-safe
+// helpers in modular-arithmetic.h and never overflow T.
+
+// Primality for any n: deterministic Miller-Rabin over the 64-bit range
+template <typename T>
+constexpr bool isPrime(T n) {
+    return n > 1 && isPrimeMillerRabin((uint64_t)n);
+}
+
+// Greatest Common Divisor of |a| and |b| by the binary algorithm (binaryGcd)
+template <typename T>
+constexpr T gcd(T a, T b) {
+    static_assert(sizeof(T) <= sizeof(uint64_t), "gcd works on integers of at most 64 bits");
+    uint64_t x = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+    uint64_t y = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+    return (T)binaryGcd(x, y);
+}
+
+// Extended Euclidean Algorithm, iteratively
+// Returns gcd(a, b) and finds x, y such that ax + by = gcd(a, b). The
+// coefficients are the ones the recursive formulation produces and stay
+// within |b| and |a|, so nothing overflows for signed T up to 64 bits.
+template <typename T>
+constexpr T extendedGCD(T a, T b, T& x, T& y) {
+    static_assert(std::is_signed<T>::value, "extendedGCD needs a signed type for its coefficients");
+    T oldR = a, r = b;
+    T oldX = 1, nextX = 0;
+    T oldY = 0, nextY = 1;
+    while (r != 0) {
+        T q = oldR / r;
+        T t = oldR - q * r;
+        oldR = r;
+        r = t;
+        t = oldX - q * nextX;
+        oldX = nextX;
+        nextX = t;
+        t = oldY - q * nextY;
+        oldY = nextY;
+        nextY = t;
+    }
+    x = oldX;
+    y = oldY;
+    return oldR;
+}
+
+// Modular inverse of a modulo m > 0 in [0, m), or -1 (all ones for unsigned T)
+// when gcd(a, m) != 1
+template <typename T>
+constexpr T modularInverse(T a, T m) {
+    if (m <= 0) return -1;
+    T r = a % m;
+    if (r < 0) r += m;
+    uint64_t inverse = 0;
+    return inverseMod(r, m, inverse) ? (T)inverse : (T)-1;
+}
+
+// (base^exp) % mod by fast exponentiation for any base; -1 for mod <= 0 or a
+// negative exponent
+template <typename T>
+constexpr T fastPower(T base, T exp, T mod) {
+    if (mod <= 0 || exp < 0) return -1;
+    T r = base % mod;
+    if (r < 0) r += mod;
+    return powerMod(r, exp, mod);
+}
+
+// Prime Factorization
+// Trial division by small primes, then Miller-Rabin and Pollard-Rho-Brent
+// (pollard-rho.h), so any 64-bit n factors in microseconds
+template <typename T>
+std::vector<std::pair<T, int>> primeFactorization(T n) {
+    std::vector<std::pair<T, int>> factors;
+    if (n < 2) return factors;
+    
+    forEachPrimeFactor(n, [&](uint64_t p, int e) { factors.push_back({(T)p, e}); });
+    
+    return factors;
+}
+
+// The same with the result taken from resource, reserved for the at most 15
+// distinct primes of a 64-bit n so it is allocated once
+template <typename T>
+std::pmr::vector<std::pair<T, int>> primeFactorization(T n, std::pmr::memory_resource* resource) {
+    std::pmr::vector<std::pair<T, int>> factors(resource);
+    if (n < 2) return factors;
+    
+    factors.reserve(15);
+    forEachPrimeFactor(n, [&](uint64_t p, int e) { factors.push_back({(T)p, e}); });
+    
+    return factors;
+}
+
+// Euler's Totient Function (φ(n))
+template <typename T>
+constexpr T eulerTotient(T n) {
+    T result = n;
+    
+    // Consider all prime factors of n
+    for (T i = 2; i <= n / i; i++) {
+        if (n % i == 0) {
+            // Remove all factors of i from n
+            while (n % i == 0) {
+                n /= i;
+            }
+            // Multiply result with (1 - 1/i)
+            result -= result / i;
+        }
+    }
+    
+    // If n has a prime factor greater than sqrt(n)
+    if (n > 1) {
+        result -= result / n;
+    }
+    
+    return result;
+}
+
+// Wilson's Theorem: (p-1)! ≡ -1 (mod p) if and only if p is prime
+// Linear in p; FactorialTable::satisfiesWilson (combinatorics.h) answers it
+// from a table that is already built
+template <typename T>
+constexpr bool wilsonTheorem(T p) {
+    if (p <= 1) return false;
+    
+    uint64_t factorial = 1;
+    for (T i = 1; i < p; i++) {
+        factorial = mulMod(factorial, i, p);
+    }
+    
+    return factorial == (uint64_t)p - 1; // -1 ≡ p-1 (mod p)
+}
+
+} // namespace number_elite
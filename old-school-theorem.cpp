@@ -1,142 +1,92 @@
 #include <iostream>
-#include <cmath>
 #include <vector>
+#include <cstdint>
+#include <random>
+#include "number-theory.h"
+#include "trial-division.h"
+#include "smallest-prime-factor.h"
+#include "sieve.h"
+#include "small-primes.h"
+#include "batch-primality.h"
+#include "combinatorics.h"
 using namespace std;
+using namespace number_elite;
 
-// Trial Division Method - Basic primality test
-bool isPrimeTrialDivision(int n) {
-    if (n <= 1) return false;
-    if (n <= 3) return true;
-    if (n % 2 == 0 || n % 3 == 0) return false;
-    
-    for (int i = 5; i * i <= n; i += 6) {
-        if (n % i == 0 || n % (i + 2) == 0)
+// Checks Miller-Rabin against a sieve for every n <= limit
+bool verifyMillerRabin(int limit) {
+    vector<bool> sieved = sieveOfEratosthenes(limit);
+    for (int n = 0; n <= limit; n++) {
+        if (isPrime(n) != sieved[n]) {
+            cout << "Mismatch at " << n << endl;
             return false;
+        }
     }
     return true;
 }
 
-// Greatest Common Divisor using Euclidean Algorithm
-int gcd(int a, int b) {
-    if (b == 0) return a;
-    return gcd(b, a % b);
-}
-
-// Extended Euclidean Algorithm
-// Returns gcd(a, b) and finds x, y such that ax + by = gcd(a, b)
-int extendedGCD(int a, int b, int& x, int& y) {
-    if (b == 0) {
-        x = 1;
-        y = 0;
-        return a;
+// Checks the compile-time prime table and bitmap against a runtime sieve
+bool verifySmallPrimeTables() {
+    vector<bool> sieved = sieveOfEratosthenes((int)SMALL_PRIME_LIMIT - 1);
+    uint32_t count = 0;
+    for (uint32_t n = 0; n < SMALL_PRIME_LIMIT; n++) {
+        if (isSmallPrime(n) != sieved[n]) return false;
+        if (sieved[n] && SMALL_PRIMES.primes[count++] != n) return false;
     }
-    
-    int x1, y1;
-    int gcd_val = extendedGCD(b, a % b, x1, y1);
-    
-    x = y1;
-    y = x1 - (a / b) * y1;
-    
-    return gcd_val;
+    return count == SMALL_PRIME_COUNT;
 }
 
-// Modular Inverse using Extended Euclidean Algorithm
-int modularInverse(int a, int m) {
-    int x, y;
-    int gcd_val = extendedGCD(a, m, x, y);
-    
-    if (gcd_val != 1) {
-        cout << "Modular inverse doesn't exist" << endl;
-        return -1;
-    }
-    
-    return (x % m + m) % m;
-}
-
-// Fast Exponentiation (Power with modulo)
-long long fastPower(long long base, long long exp, long long mod) {
-    long long result = 1;
-    base = base % mod;
-    
-    while (exp > 0) {
-        if (exp % 2 == 1) {
-            result = (result * base) % mod;
-        }
-        exp = exp >> 1;
-        base = (base * base) % mod;
-    }
-    
-    return result;
-}
-
-// Prime Factorization
-vector<pair<int, int>> primeFactorization(int n) {
-    vector<pair<int, int>> factors;
-    
-    // Count factors of 2
-    int count = 0;
-    while (n % 2 == 0) {
-        count++;
-        n /= 2;
-    }
-    if (count > 0) {
-        factors.push_back({2, count});
-    }
-    
-    // Count odd factors
-    for (int i = 3; i <= sqrt(n); i += 2) {
-        count = 0;
-        while (n % i == 0) {
-            count++;
-            n /= i;
+// Checks FactorialTable against Pascal's triangle and direct products for
+// n < 200 and small primes, with tables from empty to complete, so the
+// arguments past an incomplete table are covered too
+bool verifyFactorialTable() {
+    const uint64_t N = 200;
+    for (uint64_t p : {2, 3, 7, 13, 101}) {
+        vector<vector<uint64_t>> pascal(N, vector<uint64_t>(N, 0));
+        for (uint64_t n = 0; n < N; n++) {
+            pascal[n][0] = 1 % p;
+            for (uint64_t r = 1; r <= n; r++) pascal[n][r] = (pascal[n - 1][r - 1] + pascal[n - 1][r]) % p;
         }
-        if (count > 0) {
-            factors.push_back({i, count});
-        }
-    }
-    
-    // If n is still > 1, then it's a prime
-    if (n > 1) {
-        factors.push_back({n, 1});
-    }
-    
-    return factors;
-}
-
-// Euler's Totient Function (φ(n))
-int eulerTotient(int n) {
-    int result = n;
-    
-    // Consider all prime factors of n
-    for (int i = 2; i * i <= n; i++) {
-        if (n % i == 0) {
-            // Remove all factors of i from n
-            while (n % i == 0) {
-                n /= i;
+        
+        for (uint64_t limit : {(uint64_t)0, (uint64_t)1, p / 2, p - 1}) {
+            FactorialTable table(p, limit);
+            uint64_t withoutP = 1 % p;
+            for (uint64_t n = 0; n < N; n++) {
+                if (n > 0) {
+                    uint64_t factor = n;
+                    while (factor % p == 0) factor /= p;
+                    withoutP = withoutP * factor % p;
+                }
+                if (table.factorialWithoutP(n) != withoutP) return false;
+                
+                uint64_t falling = 1 % p;
+                for (uint64_t r = 0; r <= n; r++) {
+                    if (table.binomial(n, r) != pascal[n][r] || table.permutations(n, r) != falling) return false;
+                    falling = falling * ((n - r) % p) % p;
+                }
             }
-            // Multiply result with (1 - 1/i)
-            result -= result / i;
         }
     }
-    
-    // If n has a prime factor greater than sqrt(n)
-    if (n > 1) {
-        result -= result / n;
-    }
-    
-    return result;
+    return true;
 }
 
-// Wilson's Theorem: (p-1)! ≡ -1 (mod p) if and only if p is prime
-bool wilsonTheorem(int p) {
-    if (p <= 1) return false;
+// Checks the batch primality test against the scalar one on every n below
+// 2^20, random 32-bit values and the top of the 32-bit range
+bool verifyPrimeBatch() {
+    vector<uint32_t> values;
+    for (uint32_t n = 0; n < (1 << 20); n++) values.push_back(n);
+    mt19937 rng(2024);
+    for (int i = 0; i < (1 << 20); i++) values.push_back(rng());
+    for (uint32_t n = 0; n < (1 << 16); n++) values.push_back(UINT32_MAX - n);
     
-    long long factorial = 1;
-    for (int i = 1; i < p; i++) {
-        factorial = (factorial * i) % p;
+    vector<uint8_t> results(values.size());
+    isPrimeBatch(values.data(), values.size(), results.data());
+    for (size_t i = 0; i < values.size(); i++) {
+        if (results[i] != isPrimeMillerRabin(values[i])) {
+            cout << "Mismatch at " << values[i] << endl;
+            return false;
+        }
     }
-    
-    return factorial == p - 1; // -1 ≡ p-1 (mod p)
+    return true;
 }
 
 int main() {
@@ -147,16 +97,20 @@ int main() {
     while (true) {
         cout << "\nChoose an algorithm:" << endl;
         cout << "1. Prime Check (Trial Division)" << endl;
-        cout << "2. GCD (Euclidean Algorithm)" << endl;
+        cout << "2. GCD (Binary Algorithm)" << endl;
         cout << "3. Extended GCD" << endl;
         cout << "4. Modular Inverse" << endl;
         cout << "5. Fast Exponentiation" << endl;
-        cout << "6. Prime Factorization" << endl;
+        cout << "6. Prime Factorization (64-bit)" << endl;
         cout << "7. Euler's Totient Function" << endl;
         cout << "8. Wilson's Theorem" << endl;
+        cout << "9. Prime Check (Miller-Rabin, 64-bit)" << endl;
+        cout << "10. Verify Miller-Rabin against a sieve" << endl;
+        cout << "11. Bulk queries (smallest prime factor table)" << endl;
+        cout << "12. Run self-checks (prime tables, batch primality, factorial tables)" << endl;
         cout << "0. Exit" << endl;
         cout << "Enter choice: ";
-        cin >> choice;
+        if (!(cin >> choice)) break;
         
         switch (choice) {
             case 1:
@@ -174,8 +128,8 @@ int main() {
                 cin >> a >> b;
                 cout << "GCD(" << a << ", " << b << ") = " << gcd(a, b) << endl;
                 break;
-                
-            case 3:
+            
+            case 3: {
                 cout << "Enter two numbers: ";
                 cin >> a >> b;
                 int x, y;
@@ -183,35 +137,42 @@ int main() {
                 cout << "GCD(" << a << ", " << b << ") = " << gcd_val << endl;
                 cout << "Coefficients: " << a << "*(" << x << ") + " << b << "*(" << y << ") = " << gcd_val << endl;
                 break;
-                
-            case 4:
+            }
+            
+            case 4: {
                 cout << "Enter number and modulus: ";
                 cin >> a >> m;
                 int inv = modularInverse(a, m);
                 if (inv != -1) {
                     cout << "Modular inverse of " << a << " mod " << m << " = " << inv << endl;
                     cout << "Verification: " << a << " * " << inv << " mod " << m << " = " << (a * inv) % m << endl;
+                } else {
+                    cout << "Modular inverse doesn't exist" << endl;
                 }
                 break;
-                
-            case 5:
+            }
+            
+            case 5: {
                 long long base, exp, mod;
                 cout << "Enter base, exponent, and modulus: ";
                 cin >> base >> exp >> mod;
                 cout << base << "^" << exp << " mod " << mod << " = " << fastPower(base, exp, mod) << endl;
                 break;
-                
-            case 6:
+            }
+            
+            case 6: {
+                unsigned long long value;
                 cout << "Enter number: ";
-                cin >> n;
-                cout << "Prime factorization of " << n << ": ";
-                vector<pair<int, int>> factors = primeFactorization(n);
+                cin >> value;
+                cout << "Prime factorization of " << value << ": ";
+                vector<pair<unsigned long long, int>> factors = primeFactorization(value);
                 for (auto factor : factors) {
                     cout << factor.first << "^" << factor.second << " ";
                 }
                 cout << endl;
                 break;
-                
+            }
+            
             case 7:
                 cout << "Enter number: ";
                 cin >> n;
@@ -227,7 +188,68 @@ int main() {
                     cout << n << " doesn't satisfy Wilson's theorem (not prime)" << endl;
                 }
                 break;
+            
+            case 9: {
+                unsigned long long value;
+                cout << "Enter number: ";
+                cin >> value;
+                if (isPrime(value)) {
+                    cout << value << " is prime" << endl;
+                } else {
+                    cout << value << " is not prime" << endl;
+                }
+                break;
+            }
+            
+            case 10:
+                cout << "Enter limit: ";
+                cin >> n;
+                if (verifyMillerRabin(n)) {
+                    cout << "✓ Miller-Rabin agrees with the sieve for all numbers up to " << n << endl;
+                } else {
+                    cout << "✗ Miller-Rabin disagrees with the sieve!" << endl;
+                }
+                break;
+                
+            case 12:
+                if (verifySmallPrimeTables()) {
+                    cout << "✓ The compile-time prime table agrees with the sieve below 2^16" << endl;
+                } else {
+                    cout << "✗ The compile-time prime table disagrees with the sieve!" << endl;
+                }
+                if (verifyPrimeBatch()) {
+                    cout << "✓ The batch primality test agrees with Miller-Rabin" << endl;
+                } else {
+                    cout << "✗ The batch primality test disagrees with Miller-Rabin!" << endl;
+                }
+                if (verifyFactorialTable()) {
+                    cout << "✓ Factorial tables agree with Pascal's triangle, complete or not" << endl;
+                } else {
+                    cout << "✗ Factorial tables disagree with Pascal's triangle!" << endl;
+                }
+                break;
+            
+            case 11: {
+                cout << "Enter range [a, b]: ";
+                cin >> a >> b;
+                if (a < 1 || b < a) {
+                    cout << "Invalid range!" << endl;
+                    break;
+                }
                 
+                // One table answers every query in the range
+                SmallestPrimeFactorTable table(b);
+                for (int value = a; value <= b; value++) {
+                    cout << value << " =";
+                    table.forEachPrimeFactor(value, [](uint32_t p, int e) {
+                        cout << " " << p << "^" << e;
+                    });
+                    cout << "  d=" << table.divisorCount(value) << " sigma=" << table.divisorSum(value)
+                         << " phi=" << table.totient(value) << " mu=" << table.mobius(value) << endl;
+                }
+                break;
+            }
+            
             case 0:
                 cout << "Exiting..." << endl;
                 return 0;
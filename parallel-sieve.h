@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include "sieve.h"
+
+namespace number_elite {
+
+// Worker count used when the caller passes threads = 0
+inline unsigned defaultThreadCount() {
+    unsigned threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1;
+}
+
+// Runs task(i) for every i in [0, tasks) on a pool of threads; tasks are
+// claimed dynamically so uneven tasks still balance. One thread runs inline.
+template <typename Task>
+void parallelFor(size_t tasks, unsigned threads, Task task) {
+    if (threads == 0) threads = defaultThreadCount();
+    if (threads == 1 || tasks <= 1) {
+        for (size_t i = 0; i < tasks; i++) task(i);
+        return;
+    }
+    
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < std::min<size_t>(threads, tasks); t++) {
+        pool.emplace_back([&]() {
+            for (size_t i; (i = next++) < tasks;) task(i);
+        });
+    }
+    for (std::thread& worker : pool) worker.join();
+}
+
+// Splits the wheel bytes of [0, n] into chunks of whole segments. Each worker
+// sieves a chunk with its own WheelSieve and the shared base primes.
+struct WheelChunks {
+    uint64_t n;
+    uint64_t chunkBytes;
+    size_t count;
+    std::shared_ptr<const std::pmr::vector<uint32_t>> basePrimes;
+    
+    WheelChunks(uint64_t n, unsigned threads, size_t segmentBytes, uint64_t maxChunkBytes)
+        : n(n), basePrimes(std::make_shared<const std::pmr::vector<uint32_t>>(wheelBasePrimes(n))) {
+        uint64_t totalBytes = n / WHEEL_SPAN + 1;
+        // Several chunks per thread keep the load balanced near the end of the range
+        uint64_t target = (totalBytes + 8 * threads - 1) / (8 * threads);
+        chunkBytes = std::min(std::max<uint64_t>(target, segmentBytes), std::max<uint64_t>(maxChunkBytes, segmentBytes));
+        chunkBytes = (chunkBytes + segmentBytes - 1) / segmentBytes * segmentBytes;
+        count = (totalBytes + chunkBytes - 1) / chunkBytes;
+    }
+    
+    WheelSieve sieve(size_t chunk, size_t segmentBytes) const {
+        return WheelSieve(n, chunk * chunkBytes, (chunk + 1) * chunkBytes, basePrimes, segmentBytes);
+    }
+};
+
+// Number of primes <= n, with chunks counted independently on a pool of threads
+inline uint64_t parallelCountPrimes(uint64_t n, unsigned threads = 0,
+                                    size_t segmentBytes = l1DataCacheSize()) {
+    if (threads == 0) threads = defaultThreadCount();
+    if (threads == 1 || n < 7) return WheelSieve(n, segmentBytes).countPrimes();
+    
+    WheelChunks chunks(n, threads, segmentBytes, UINT64_MAX);
+    std::vector<uint64_t> counts(chunks.count);
+    parallelFor(chunks.count, threads, [&](size_t c) {
+        counts[c] = chunks.sieve(c, segmentBytes).countPrimes();
+    });
+    
+    uint64_t total = 0;
+    for (uint64_t count : counts) total += count;
+    return total;
+}
+
+// Calls callback(p) for every prime p <= n in increasing order. Chunks are sieved
+// out of order by the pool and handed to callback in order on the calling thread;
+// at most two chunks per thread are buffered at any time.
+template <typename Callback>
+void parallelForEachPrime(uint64_t n, Callback callback, unsigned threads = 0,
+                          size_t segmentBytes = l1DataCacheSize()) {
+    if (threads == 0) threads = defaultThreadCount();
+    if (threads == 1 || n < 7) {
+        WheelSieve(n, segmentBytes).forEachPrime(callback);
+        return;
+    }
+    
+    WheelChunks chunks(n, threads, segmentBytes, 8 * (uint64_t)segmentBytes);
+    size_t window = 2 * threads;
+    std::vector<std::vector<uint64_t>> results(chunks.count);
+    std::vector<bool> ready(chunks.count, false);
+    size_t nextChunk = 0, consumed = 0;
+    std::mutex lock;
+    std::condition_variable changed;
+    
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < std::min<size_t>(threads, chunks.count); t++) {
+        pool.emplace_back([&]() {
+            while (true) {
+                size_t c;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    changed.wait(guard, [&]() {
+                        return nextChunk >= chunks.count || nextChunk < consumed + window;
+                    });
+                    if (nextChunk >= chunks.count) return;
+                    c = nextChunk++;
+                }
+                
+                std::vector<uint64_t> primes;
+                chunks.sieve(c, segmentBytes).forEachPrime([&](uint64_t p) { primes.push_back(p); });
+                
+                std::lock_guard<std::mutex> guard(lock);
+                results[c] = std::move(primes);
+                ready[c] = true;
+                changed.notify_all();
+            }
+        });
+    }
+    
+    for (size_t c = 0; c < chunks.count; c++) {
+        std::vector<uint64_t> primes;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            changed.wait(guard, [&]() { return ready[c]; });
+            primes = std::move(results[c]);
+            consumed = c + 1;
+            changed.notify_all();
+        }
+        for (uint64_t p : primes) callback(p);
+    }
+    for (std::thread& worker : pool) worker.join();
+}
+
+// Parallel Segmented Sieve: the same primes as segmentedSieve, in order
+template <typename T>
+std::vector<T> parallelSegmentedSieve(T n, unsigned threads = 0) {
+    std::vector<T> result;
+    if (n < 2) return result;
+    
+    if (threads == 0) threads = defaultThreadCount();
+    WheelChunks chunks(n, threads, l1DataCacheSize(), UINT64_MAX);
+    std::vector<std::vector<T>> parts(chunks.count);
+    parallelFor(chunks.count, threads, [&](size_t c) {
+        chunks.sieve(c, l1DataCacheSize()).forEachPrime([&](uint64_t p) { parts[c].push_back(p); });
+    });
+    
+    // Ordered merge: chunks cover consecutive ranges, so concatenation keeps the order
+    size_t total = 0;
+    for (const std::vector<T>& part : parts) total += part.size();
+    result.reserve(total);
+    for (const std::vector<T>& part : parts) result.insert(result.end(), part.begin(), part.end());
+    
+    return result;
+}
+
+} // namespace number_elite
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "modular-arithmetic.h"
+#include "miller-rabin.h"
+#include "small-primes.h"
+
+namespace number_elite {
+
+// Trial division before Pollard-Rho takes over covers the first this many
+// entries of SMALL_PRIMES, the primes below 256
+const int FACTOR_TRIAL_PRIME_COUNT = 54;
+
+// Products of |x - y| are accumulated this many steps before each gcd
+const int RHO_BATCH = 128;
+
+// A non-trivial factor of an odd composite n by Pollard-Rho with Brent's cycle
+// detection. The walk x -> x^2 + c runs in Montgomery form; a factor of R = 2^64
+// cannot divide odd n, so gcds can be taken on Montgomery values directly.
+inline uint64_t pollardBrent(uint64_t n) {
+    Montgomery64 m(n);
+    
+    for (uint64_t c = 1;; c++) {
+        uint64_t increment = m.toMontgomery(c);
+        auto step = [&](uint64_t v) {
+            uint64_t square = m.multiply(v, v);
+            return square >= n - increment ? square - (n - increment) : square + increment;
+        };
+        
+        uint64_t x = 0, y = m.toMontgomery(2), saved = y;
+        uint64_t product = m.r, g = 1;
+        
+        for (uint64_t length = 1; g == 1; length *= 2) {
+            x = y;
+            for (uint64_t i = 0; i < length; i++) y = step(y);
+            
+            for (uint64_t done = 0; done < length && g == 1; done += RHO_BATCH) {
+                saved = y;
+                uint64_t batch = std::min<uint64_t>(RHO_BATCH, length - done);
+                for (uint64_t i = 0; i < batch; i++) {
+                    y = step(y);
+                    product = m.multiply(product, x > y ? x - y : y - x);
+                }
+                g = binaryGcd(product, n);
+            }
+        }
+        
+        // The batch overshot to a multiple of n: replay it one step at a time
+        if (g == n) {
+            do {
+                saved = step(saved);
+                g = binaryGcd(x > saved ? x - saved : saved - x, n);
+            } while (g == 1);
+        }
+        
+        if (g != n) return g;
+    }
+}
+
+// Calls found(p) for every prime factor p of n (with repetition), in no
+// particular order
+template <typename Callback>
+void splitPrimeFactors(uint64_t n, Callback& found) {
+    if (n == 1) return;
+    if (isPrimeMillerRabin(n)) {
+        found(n);
+        return;
+    }
+    uint64_t d = pollardBrent(n);
+    splitPrimeFactors(d, found);
+    splitPrimeFactors(n / d, found);
+}
+
+// Appends the prime factors of n (with repetition) to factors
+inline void collectPrimeFactors(uint64_t n, std::vector<uint64_t>& factors) {
+    auto append = [&](uint64_t p) { factors.push_back(p); };
+    splitPrimeFactors(n, append);
+}
+
+// Calls visit(p, e) for every prime power p^e exactly dividing n, p
+// increasing, without allocating: trial division by the primes below 256,
+// then Miller-Rabin and Pollard-Rho-Brent on whatever remains
+template <typename Visitor>
+void forEachPrimeFactor(uint64_t n, Visitor visit) {
+    if (n < 2) return;
+    
+    for (int i = 0; i < FACTOR_TRIAL_PRIME_COUNT; i++) {
+        uint64_t p = SMALL_PRIMES.primes[i];
+        if (n % p == 0) {
+            int count = 0;
+            do {
+                n /= p;
+                count++;
+            } while (n % p == 0);
+            visit(p, count);
+        }
+    }
+    
+    // No factor below 256 left, so anything under 256^2 is prime
+    if (n < 257 * 257) {
+        if (n > 1) visit(n, 1);
+        return;
+    }
+    
+    // ... and anything larger has at most 7 prime factors, as 257^8 > 2^64
+    uint64_t large[8];
+    int count = 0;
+    auto append = [&](uint64_t p) { large[count++] = p; };
+    splitPrimeFactors(n, append);
+    for (int i = 1; i < count; i++) {
+        for (int j = i; j > 0 && large[j - 1] > large[j]; j--) std::swap(large[j - 1], large[j]);
+    }
+    for (int i = 0; i < count;) {
+        int j = i;
+        while (j < count && large[j] == large[i]) j++;
+        visit(large[i], j - i);
+        i = j;
+    }
+}
+
+// Prime factorization of any 64-bit n as (prime, exponent) pairs in increasing
+// order
+inline std::vector<std::pair<uint64_t, int>> factorize(uint64_t n) {
+    std::vector<std::pair<uint64_t, int>> result;
+    forEachPrimeFactor(n, [&](uint64_t p, int e) { result.push_back({p, e}); });
+    return result;
+}
+
+} // namespace number_elite
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include "small-primes.h"
+
+namespace number_elite {
+
+// Smallest prime factors of every n below a limit that grows on demand, for
+// many threads answering queries at once. The numbers are cut into segments
+// of SEGMENT_SPAN; a segment is built once, never changes and is never freed
+// while the cache lives. Publishing one is a pointer store into a directory
+// sized for the largest limit, then a release store of the segment count, so
+// readers only load that count and never take a lock or wait for a grower.
+// Growth is serialized by a mutex that readers never touch, and is bounded
+// per call so no single query pays for building the whole range.
+//
+// Per odd n a segment keeps the smallest prime factor in 16 bits (every
+// composite below 2^32 has one below 2^16) and a primality bit, plus counts
+// for pi(x): about 1.1 bytes per number in all.
+class PrimeCache {
+public:
+    static const uint32_t SEGMENT_SPAN = 1 << 20;
+    static const uint32_t RANK_SPAN = 4096;         // numbers per pi(x) checkpoint
+    static const int GROW_SEGMENTS_PER_CALL = 1;     // a few milliseconds each
+    
+    // maxLimit is rounded up to whole segments and capped at 2^32
+    explicit PrimeCache(uint64_t maxLimit = 1 << 26)
+        : maxSegments((std::min<uint64_t>(maxLimit, 1ull << 32) + SEGMENT_SPAN - 1) / SEGMENT_SPAN),
+          directory(new std::unique_ptr<const Segment>[maxSegments]) {}
+    
+    PrimeCache(const PrimeCache&) = delete;
+    PrimeCache& operator=(const PrimeCache&) = delete;
+    
+    // Every n < limit() can be queried; the limit only grows
+    uint64_t limit() const { return (uint64_t)published.load(std::memory_order_acquire) * SEGMENT_SPAN; }
+    uint64_t maxLimit() const { return (uint64_t)maxSegments * SEGMENT_SPAN; }
+    bool covers(uint64_t n) const { return n < limit(); }
+    
+    // Extends the cache towards n, by at most GROW_SEGMENTS_PER_CALL segments,
+    // unless another thread is already growing it. Returns covers(n)
+    // afterwards; callers answer uncovered queries some other way.
+    bool tryCover(uint64_t n) {
+        if (covers(n)) return true;
+        if (n >= maxLimit()) return false;
+        std::unique_lock<std::mutex> lock(growMutex, std::try_to_lock);
+        if (!lock.owns_lock()) return covers(n);
+        
+        uint32_t count = published.load(std::memory_order_relaxed);
+        for (int i = 0; i < GROW_SEGMENTS_PER_CALL && (uint64_t)count * SEGMENT_SPAN <= n; i++) {
+            uint64_t primesBefore = count == 0 ? 0 : directory[count - 1]->primesBefore + directory[count - 1]->primes;
+            directory[count].reset(buildSegment(count, primesBefore));
+            published.store(++count, std::memory_order_release);
+        }
+        return covers(n);
+    }
+    
+    // Smallest prime factor of 2 <= n < limit()
+    uint32_t smallestPrimeFactor(uint32_t n) const {
+        if (n % 2 == 0) return 2;
+        uint32_t p = segmentOf(n).spf[n % SEGMENT_SPAN / 2];
+        return p == 0 ? n : p;
+    }
+    
+    // Primality of n < limit()
+    bool isPrime(uint32_t n) const {
+        if (n % 2 == 0) return n == 2;
+        uint32_t i = n % SEGMENT_SPAN / 2;
+        return segmentOf(n).bits[i / 64] >> (i % 64) & 1;
+    }
+    
+    // Calls visit(p, e) for every prime power p^e exactly dividing
+    // 1 <= n < limit(), p increasing
+    template <typename Visitor>
+    void forEachPrimeFactor(uint32_t n, Visitor visit) const {
+        if (n >= 2 && n % 2 == 0) {
+            int e = __builtin_ctz(n);
+            n >>= e;
+            visit(2u, e);
+        }
+        while (n > 1) {
+            uint32_t p = smallestPrimeFactor(n);
+            int e = 0;
+            do {
+                n /= p;
+                e++;
+            } while (n % p == 0);
+            visit(p, e);
+        }
+    }
+    
+    // pi(x) for x < limit(): the count before x's segment and checkpoint, then
+    // popcounts over at most RANK_SPAN / 128 words
+    uint64_t primeCount(uint32_t x) const {
+        if (x < 2) return 0;
+        const Segment& segment = segmentOf(x);
+        uint32_t offset = x % SEGMENT_SPAN;
+        uint32_t checkpoint = offset / RANK_SPAN;
+        uint64_t count = 1 + segment.primesBefore + segment.ranks[checkpoint];   // 1 for the prime 2
+        uint32_t end = (offset + 1) / 2;   // odd numbers <= x in the segment
+        for (uint32_t w = checkpoint * RANK_SPAN / 128; w < end / 64; w++) count += __builtin_popcountll(segment.bits[w]);
+        if (end % 64 != 0) count += __builtin_popcountll(segment.bits[end / 64] & ((1ull << end % 64) - 1));
+        return count;
+    }
+    
+    // Bytes held by the published segments
+    size_t memoryBytes() const { return (size_t)published.load(std::memory_order_acquire) * sizeof(Segment); }
+    
+private:
+    // Odd n in [SEGMENT_SPAN * k, SEGMENT_SPAN * (k + 1)), at index n % SEGMENT_SPAN / 2
+    struct Segment {
+        uint16_t spf[SEGMENT_SPAN / 2];          // 0 for primes (and 1)
+        uint64_t bits[SEGMENT_SPAN / 128];       // set for odd primes
+        uint32_t ranks[SEGMENT_SPAN / RANK_SPAN];  // odd primes in the segment before each checkpoint
+        uint64_t primesBefore;                   // odd primes in the segments before
+        uint64_t primes;                         // odd primes in this segment
+    };
+    
+    uint32_t maxSegments;
+    std::unique_ptr<std::unique_ptr<const Segment>[]> directory;
+    std::atomic<uint32_t> published{0};
+    std::mutex growMutex;
+    
+    const Segment& segmentOf(uint32_t n) const { return *directory[n / SEGMENT_SPAN]; }
+    
+    // Sieves segment k with the odd primes below 2^16, largest first, so the
+    // smallest prime dividing an odd multiple m >= p^2 is the last stored there
+    static Segment* buildSegment(uint32_t k, uint64_t primesBefore) {
+        Segment* segment = new Segment();
+        uint64_t low = (uint64_t)k * SEGMENT_SPAN, high = low + SEGMENT_SPAN;
+        for (uint32_t i = SMALL_PRIME_COUNT - 1; i >= 1; i--) {
+            uint64_t p = SMALL_PRIMES.primes[i];
+            if (p * p >= high) continue;
+            uint64_t m = std::max(p * p, (low + p - 1) / p * p);
+            if (m % 2 == 0) m += p;
+            for (; m < high; m += 2 * p) segment->spf[(m - low) / 2] = p;
+        }
+        
+        uint64_t count = 0;
+        for (uint32_t i = 0; i < SEGMENT_SPAN / 2; i++) {
+            if (i % (RANK_SPAN / 2) == 0) segment->ranks[i / (RANK_SPAN / 2)] = count;
+            if (segment->spf[i] == 0 && low + 2 * i + 1 > 1) {
+                segment->bits[i / 64] |= 1ull << (i % 64);
+                count++;
+            }
+        }
+        segment->primesBefore = primesBefore;
+        segment->primes = count;
+        return segment;
+    }
+};
+
+} // namespace number_elite
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "sieve.h"
+#include "parallel-sieve.h"
+
+namespace number_elite {
+
+// Below this pi(x) is counted directly with the wheel sieve
+const uint64_t PRIME_COUNT_SIEVE_LIMIT = 10000000;
+
+// phi(x, c) = #{1 <= n <= x : n has no prime factor among the first c primes}.
+// For c <= 6 it is periodic modulo the primorial pp, so
+// phi(x, c) = (x / pp) * phi(pp, c) + phi(x % pp, c) is a table lookup.
+struct PhiTiny {
+    static const int MAX_C = 6;
+    int64_t primorial[MAX_C + 1];
+    int64_t totient[MAX_C + 1];
+    std::vector<uint16_t> table[MAX_C + 1];
+    
+    PhiTiny() {
+        const int smallPrimes[MAX_C] = {2, 3, 5, 7, 11, 13};
+        primorial[0] = 1;
+        for (int c = 1; c <= MAX_C; c++) primorial[c] = primorial[c - 1] * smallPrimes[c - 1];
+        
+        for (int c = 0; c <= MAX_C; c++) {
+            table[c].assign(primorial[c], 0);
+            int count = 0;
+            for (int64_t i = 1; i <= primorial[c]; i++) {
+                bool coprime = true;
+                for (int k = 0; k < c; k++) {
+                    if (i % smallPrimes[k] == 0) coprime = false;
+                }
+                if (coprime) count++;
+                if (i < primorial[c]) table[c][i] = count;
+            }
+            totient[c] = count;
+        }
+    }
+    
+    int64_t phi(int64_t x, int c) const {
+        return x / primorial[c] * totient[c] + table[c][x % primorial[c]];
+    }
+};
+
+inline const PhiTiny& phiTiny() {
+    static const PhiTiny tiny;
+    return tiny;
+}
+
+// Segment of [low, high) for the special leaves: one bit per number that is
+// still unsieved, plus a counter per block of bits so prefix counts need only
+// a few additions and popcounts while removing a number stays O(1)
+class PhiSegment {
+public:
+    static const int BLOCK_SHIFT = 10;
+    
+    explicit PhiSegment(size_t size) : bits(size / 64), counters(size >> BLOCK_SHIFT) {}
+    
+    void reset(int64_t low, int64_t high, const std::vector<int32_t>& primes, int c) {
+        this->low = low;
+        this->high = high;
+        size_t size = high - low;
+        std::fill(bits.begin(), bits.end(), 0);
+        for (size_t i = 0; i < size / 64; i++) bits[i] = ~0ULL;
+        if (size % 64) bits[size / 64] = (1ULL << (size % 64)) - 1;
+        
+        // The first c primes are crossed off before the counters are built
+        for (int b = 1; b <= c; b++) {
+            int64_t p = primes[b];
+            for (int64_t n = (low + p - 1) / p * p; n < high; n += p) {
+                bits[(n - low) / 64] &= ~(1ULL << ((n - low) % 64));
+            }
+        }
+        
+        const size_t wordsPerBlock = (1 << BLOCK_SHIFT) / 64;
+        for (size_t block = 0; block < counters.size(); block++) {
+            int32_t count = 0;
+            for (size_t w = block * wordsPerBlock; w < (block + 1) * wordsPerBlock; w++) {
+                count += __builtin_popcountll(bits[w]);
+            }
+            counters[block] = count;
+        }
+    }
+    
+    // Unsieved numbers in [low, n]
+    int64_t countUpTo(int64_t n) const {
+        size_t pos = n - low;
+        size_t block = pos >> BLOCK_SHIFT;
+        int64_t count = 0;
+        for (size_t i = 0; i < block; i++) count += counters[i];
+        for (size_t w = block << (BLOCK_SHIFT - 6); w < pos / 64; w++) {
+            count += __builtin_popcountll(bits[w]);
+        }
+        return count + __builtin_popcountll(bits[pos / 64] & (~0ULL >> (63 - pos % 64)));
+    }
+    
+    int64_t countAll() const {
+        int64_t count = 0;
+        for (int32_t counter : counters) count += counter;
+        return count;
+    }
+    
+    void crossOff(int64_t p) {
+        for (int64_t n = (low + p - 1) / p * p; n < high; n += p) {
+            size_t pos = n - low;
+            uint64_t bit = 1ULL << (pos % 64);
+            if (bits[pos / 64] & bit) {
+                bits[pos / 64] &= ~bit;
+                counters[pos >> BLOCK_SHIFT]--;
+            }
+        }
+    }
+    
+private:
+    int64_t low = 0, high = 0;
+    std::vector<uint64_t> bits;
+    std::vector<int32_t> counters;
+};
+
+// Contribution of the special leaves from one range of [1, x / y). phi values
+// from earlier ranges are unknown here, so the sum of mu over the leaves of
+// each prime is kept and corrected once the earlier ranges are done.
+struct SpecialLeavesRange {
+    int64_t sum = 0;
+    std::vector<int64_t> muSum;
+    std::vector<int64_t> phi;
+};
+
+inline SpecialLeavesRange specialLeaves(int64_t x, int64_t y, int c, const std::vector<int32_t>& primes,
+                                        const std::vector<int32_t>& lpf, const std::vector<int8_t>& mu,
+                                        int64_t rangeLow, int64_t rangeHigh, int64_t segmentSize) {
+    int64_t a = primes.size() - 1;
+    SpecialLeavesRange range;
+    range.muSum.assign(a + 1, 0);
+    range.phi.assign(a + 1, 0);
+    PhiSegment segment(segmentSize);
+    
+    for (int64_t low = rangeLow; low < rangeHigh; low += segmentSize) {
+        int64_t high = std::min(low + segmentSize, rangeHigh);
+        segment.reset(low, high, primes, c);
+        
+        // Leaves x / (p_b * m) with p_b < lpf(m) and m <= y < p_b * m need
+        // phi(x / (p_b * m), b - 1), i.e. the segment sieved by the first b - 1 primes
+        for (int64_t b = c + 1; b < a; b++) {
+            int64_t p = primes[b];
+            int64_t minM = std::max(x / (p * high), y / p);
+            int64_t maxM = std::min(x / (p * low), y);
+            if (p >= maxM) break;
+            
+            for (int64_t m = maxM; m > minM; m--) {
+                if (mu[m] != 0 && p < lpf[m]) {
+                    range.sum -= mu[m] * (range.phi[b] + segment.countUpTo(x / (p * m)));
+                    range.muSum[b] += mu[m];
+                }
+            }
+            
+            range.phi[b] += segment.countAll();
+            segment.crossOff(p);
+        }
+    }
+    
+    return range;
+}
+
+// P2(x, a) = sum over y < p <= sqrt(x) of (pi(x / p) - pi(p) + 1), with the
+// pi(x / p) values read off a chunked sieve of [0, x / y]
+inline int64_t partialSieveP2(int64_t x, int64_t y, int64_t a, unsigned threads) {
+    int64_t sqrtX = integerSqrt(x);
+    if (sqrtX <= y) return 0;
+    
+    std::vector<uint64_t> largePrimes = primesInRange<uint64_t>(y + 1, sqrtX);
+    std::vector<uint64_t> targets;
+    for (size_t i = largePrimes.size(); i-- > 0;) targets.push_back(x / largePrimes[i]);
+    
+    WheelChunks chunks(x / y, threads, l1DataCacheSize(), UINT64_MAX);
+    std::vector<uint64_t> chunkPrimes(chunks.count), chunkTargets(chunks.count), chunkSums(chunks.count);
+    parallelFor(chunks.count, threads, [&](size_t c) {
+        uint64_t chunkLow = WHEEL_SPAN * c * chunks.chunkBytes;
+        uint64_t chunkHigh = WHEEL_SPAN * (c + 1) * chunks.chunkBytes;
+        size_t t = std::lower_bound(targets.begin(), targets.end(), chunkLow) - targets.begin();
+        size_t firstTarget = t;
+        uint64_t count = 0, sum = 0;
+        
+        chunks.sieve(c, l1DataCacheSize()).forEachPrime([&](uint64_t p) {
+            while (t < targets.size() && targets[t] < p) sum += count, t++;
+            count++;
+        });
+        while (t < targets.size() && targets[t] < chunkHigh) sum += count, t++;
+        
+        chunkPrimes[c] = count;
+        chunkTargets[c] = t - firstTarget;
+        chunkSums[c] = sum;
+    });
+    
+    int64_t p2 = 0, primesBefore = 0;
+    for (size_t c = 0; c < chunks.count; c++) {
+        p2 += chunkSums[c] + chunkTargets[c] * primesBefore;
+        primesBefore += chunkPrimes[c];
+    }
+    
+    // Subtract pi(p_k) - 1 = k - 1 for a < k <= pi(sqrt(x))
+    int64_t b = a + largePrimes.size();
+    p2 -= (b - 1) * b / 2 - (a - 1) * a / 2;
+    return p2;
+}
+
+// Number of primes <= x by the Lagarias-Miller-Odlyzko method:
+// pi(x) = phi(x, a) + a - 1 - P2(x, a) with y = x^(1/3), a = pi(y), and
+// phi(x, a) split into ordinary leaves (S1) and special leaves (S2). Runs in
+// O(x^(2/3)) time and O(x^(1/3)) memory for x < 2^63; small x falls back to
+// the sieve. The special leaves and P2 are split across threads. The leaves
+// are counted in signed 64-bit arithmetic, so x >= 2^63 is out of range and
+// returns 0 (nthPrime keeps its estimates below 2^63).
+inline uint64_t primeCount(uint64_t x, unsigned threads = 0) {
+    if (x >= 1ull << 63) return 0;
+    if (threads == 0) threads = defaultThreadCount();
+    if (x < PRIME_COUNT_SIEVE_LIMIT) return WheelSieve(x).countPrimes();
+    
+    int64_t y = std::cbrt((double)x);
+    while (y * y * y > (int64_t)x) y--;
+    while ((y + 1) * (y + 1) * (y + 1) <= (int64_t)x) y++;
+    
+    // primes[1..a] are the primes <= y; lpf[1] is larger than any prime
+    std::vector<int32_t> primes = {0};
+    for (int32_t p : segmentedSieve<int32_t>(y)) primes.push_back(p);
+    int64_t a = primes.size() - 1;
+    int c = std::min<int64_t>(PhiTiny::MAX_C, a);
+    
+    std::vector<int32_t> lpf(y + 1, 0);
+    std::vector<int8_t> mu(y + 1, 1);
+    lpf[1] = INT32_MAX;
+    for (int64_t b = a; b >= 1; b--) {
+        int64_t p = primes[b];
+        for (int64_t m = p; m <= y; m += p) {
+            lpf[m] = p;
+            mu[m] = -mu[m];
+        }
+        for (int64_t m = p * p; m <= y; m += p * p) mu[m] = 0;
+    }
+    
+    // Ordinary leaves: squarefree n <= y free of the first c primes
+    int64_t s1 = 0;
+    for (int64_t n = 1; n <= y; n++) {
+        if (mu[n] != 0 && lpf[n] > primes[c]) s1 += mu[n] * phiTiny().phi(x / n, c);
+    }
+    
+    // Special leaves over [1, x / y), split into ranges of whole segments
+    int64_t limit = x / y + 1;
+    int64_t segmentSize = 1 << 12;
+    while (segmentSize * segmentSize < limit) segmentSize *= 2;
+    int64_t segments = (limit - 1 + segmentSize - 1) / segmentSize;
+    int64_t rangeCount = std::min<int64_t>(segments, threads == 1 ? 1 : 8 * threads);
+    int64_t rangeSegments = (segments + rangeCount - 1) / rangeCount;
+    rangeCount = (segments + rangeSegments - 1) / rangeSegments;
+    
+    std::vector<SpecialLeavesRange> ranges(rangeCount);
+    parallelFor(rangeCount, threads, [&](size_t r) {
+        int64_t rangeLow = 1 + r * rangeSegments * segmentSize;
+        int64_t rangeHigh = std::min(rangeLow + rangeSegments * segmentSize, limit);
+        ranges[r] = specialLeaves(x, y, c, primes, lpf, mu, rangeLow, rangeHigh, segmentSize);
+    });
+    
+    int64_t s2 = 0;
+    std::vector<int64_t> phiBefore(a + 1, 0);
+    for (const SpecialLeavesRange& range : ranges) {
+        s2 += range.sum;
+        for (int64_t b = 1; b <= a; b++) {
+            s2 -= range.muSum[b] * phiBefore[b];
+            phiBefore[b] += range.phi[b];
+        }
+    }
+    
+    return s1 + s2 + a - 1 - partialSieveP2(x, y, a, threads);
+}
+
+// Logarithmic integral li(x) for x > 1 by Ramanujan's series, which
+// converges quickly for every x the 64-bit range needs
+inline long double logarithmicIntegral(long double x) {
+    const long double EULER_GAMMA = 0.5772156649015328606L;
+    long double logX = std::log(x);
+    long double sum = 0, term = 1, inner = 0;
+    for (int n = 1; n < 200; n++) {
+        term *= logX / n;
+        if ((n - 1) % 2 == 0) inner += 1.0L / n;
+        long double addend = term * inner / std::ldexp(1.0L, n - 1);
+        sum += n % 2 == 1 ? addend : -addend;
+        if (addend < 1e-20L * std::fabs(sum)) break;
+    }
+    return EULER_GAMMA + std::log(logX) + std::sqrt(x) * sum;
+}
+
+// The k-th prime, counting nthPrime(1) = 2, for p_k < 2^63 (k up to about
+// 2 * 10^17); 0 for k = 0 or beyond that. The estimate x = li^-1(k) is found
+// by Newton's method and clamped to Dusart's bounds
+// k (ln k + ln ln k - 1) < p_k < k (ln k + ln ln k) for k >= 6, so it lies
+// within about sqrt(x) of p_k. One pi(x) then says how many primes separate
+// x from p_k, and a PrimeIterator walks them, holding one sieve window.
+inline uint64_t nthPrime(uint64_t k, unsigned threads = 0) {
+    const uint64_t SMALL[] = {0, 2, 3, 5, 7, 11};
+    if (k < 6) return SMALL[k];
+    
+    long double logK = std::log((long double)k), logLogK = std::log(logK);
+    long double lower = k * (logK + logLogK - 1), upper = k * (logK + logLogK);
+    if (upper >= 0x1p63L) {
+        // pi(2^63 - 1) = 216289611853439384
+        if (k > 216289611853439384ull) return 0;
+        upper = 0x1p63L - 1;
+    }
+    long double x = (lower + upper) / 2;
+    for (int i = 0; i < 8; i++) {
+        long double step = (logarithmicIntegral(x) - k) * std::log(x);
+        x = std::min(std::max(x - step, lower), upper);
+        if (std::fabs(step) < 1) break;
+    }
+    
+    uint64_t estimate = (uint64_t)x;
+    uint64_t count = primeCount(estimate, threads);
+    if (count >= k) {
+        // p_count is the largest prime <= estimate; step back to p_k
+        PrimeIterator primes(estimate);
+        uint64_t p = primes.prevPrime();
+        for (uint64_t i = k; i < count; i++) p = primes.prevPrime();
+        return p;
+    }
+    PrimeIterator primes(estimate + 1);
+    uint64_t p = 0;
+    for (uint64_t i = count; i < k; i++) p = primes.nextPrime();
+    return p;
+}
+
+} // namespace number_elite
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "sieve.h"
+
+namespace number_elite {
+
+// On-disk prime index: the mod-30 wheel bits of PrimeBitset followed by the
+// number of primes before every 64-byte block, laid out so any process can
+// map the file and answer queries in place. Opening costs one mmap whatever
+// the size, and every process shares the same page-cache pages.
+//
+//   header   PrimeIndexHeader, 64 bytes
+//   words    wordCount uint64_t; byte i holds the values 30i + residue,
+//            word w the values [240w, 240w + 240)
+//   ranks    wordCount / 8 + 1 uint64_t; ranks[b] is the number of primes
+//            above 5 in the words before block b (words 8b .. 8b + 7)
+//
+// Values are stored in the host's byte order; the version field doubles as a
+// byte-order check.
+const char PRIME_INDEX_MAGIC[8] = {'N', 'E', 'P', 'R', 'I', 'M', 'E', 'S'};
+const uint32_t PRIME_INDEX_VERSION = 1;
+const uint64_t PRIME_INDEX_BLOCK_WORDS = 8;
+
+struct PrimeIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t blockWords;
+    uint64_t limit;          // every prime <= limit is in the index
+    uint64_t wordCount;      // a multiple of blockWords
+    uint64_t primeCount;     // pi(limit)
+    uint64_t wordsOffset;    // byte offsets from the start of the file
+    uint64_t ranksOffset;
+    uint64_t reserved;
+};
+
+static_assert(sizeof(PrimeIndexHeader) == 64, "the header is one cache line");
+
+// Sieves [0, n] with the wheel engine and writes its index to path, streaming
+// one segment at a time so memory stays at the segment plus the rank array.
+// The file is written under a unique temporary name in the same directory and
+// renamed into place, so readers never see a partial index and concurrent
+// writers never share a temporary. Returns false on any I/O error.
+inline bool writePrimeIndex(const std::string& path, uint64_t n) {
+    const uint64_t wordSpan = 8 * WHEEL_SPAN;
+    const uint64_t blockBytes = PRIME_INDEX_BLOCK_WORDS * 8;
+    uint64_t dataBytes = n / WHEEL_SPAN + 1;
+    
+    PrimeIndexHeader header = {};
+    std::memcpy(header.magic, PRIME_INDEX_MAGIC, sizeof(header.magic));
+    header.version = PRIME_INDEX_VERSION;
+    header.blockWords = PRIME_INDEX_BLOCK_WORDS;
+    header.limit = n;
+    header.wordCount = (dataBytes + blockBytes - 1) / blockBytes * PRIME_INDEX_BLOCK_WORDS;
+    header.wordsOffset = sizeof(PrimeIndexHeader);
+    header.ranksOffset = header.wordsOffset + header.wordCount * 8;
+    
+    // mkstemp creates the file readable by its owner only; the index is meant
+    // to be shared, so it gets the usual 0644
+    std::string temporary = path + ".XXXXXX";
+    int fd = mkstemp(&temporary[0]);
+    if (fd < 0) return false;
+    FILE* file = fchmod(fd, 0644) == 0 ? fdopen(fd, "wb") : nullptr;
+    if (!file) {
+        close(fd);
+        std::remove(temporary.c_str());
+        return false;
+    }
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    
+    // ranks[b] is pushed as word 8b goes out; the last segment's bits above n
+    // are cleared so ranks, select and nextPrime never see them
+    std::vector<uint64_t> ranks;
+    ranks.reserve(header.wordCount / PRIME_INDEX_BLOCK_WORDS + 1);
+    std::vector<uint64_t> words;
+    uint64_t written = 0, count = 0;
+    auto emit = [&](const uint64_t* data, size_t wordCount) {
+        for (size_t i = 0; i < wordCount; i++) {
+            if ((written + i) % PRIME_INDEX_BLOCK_WORDS == 0) ranks.push_back(count);
+            count += __builtin_popcountll(data[i]);
+        }
+        ok = ok && std::fwrite(data, 8, wordCount, file) == wordCount;
+        written += wordCount;
+    };
+    
+    WheelSieve(n).forEachSegment([&](uint64_t lowByte, const uint8_t* data, size_t length) {
+        length = std::min<uint64_t>(length, header.wordCount * 8 - lowByte);
+        words.assign(length / 8, 0);
+        std::memcpy(words.data(), data, length);
+        uint64_t lastWord = n / wordSpan;
+        if (lowByte / 8 <= lastWord && lastWord < lowByte / 8 + words.size()) {
+            uint64_t i = lastWord - lowByte / 8;
+            words[i] &= wheelWordBitsUpTo(n);
+            std::fill(words.begin() + i + 1, words.end(), 0);
+        }
+        emit(words.data(), words.size());
+    });
+    
+    words.assign(header.wordCount - written, 0);
+    emit(words.data(), words.size());
+    ranks.push_back(count);
+    ok = ok && std::fwrite(ranks.data(), 8, ranks.size(), file) == ranks.size();
+    
+    header.primeCount = count + (n >= 2) + (n >= 3) + (n >= 5);
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    ok = ok && std::rename(temporary.c_str(), path.c_str()) == 0;
+    if (!ok) std::remove(temporary.c_str());
+    return ok;
+}
+
+// Read-only view of a prime index file. Every query reads the mapped file
+// directly: isPrime is one bit, rank (pi) one rank entry plus at most eight
+// popcounts, select a binary search over the rank entries, and next/prev
+// prime a scan over the words up to the neighbouring prime.
+class PrimeIndex {
+public:
+    PrimeIndex() = default;
+    explicit PrimeIndex(const std::string& path) { open(path); }
+    ~PrimeIndex() { close(); }
+    
+    PrimeIndex(const PrimeIndex&) = delete;
+    PrimeIndex& operator=(const PrimeIndex&) = delete;
+    
+    // Maps the file at path, replacing any index already open. Returns false,
+    // leaving the index closed, if it cannot be mapped or is not a valid index.
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat status;
+        if (fstat(fd, &status) != 0 || (uint64_t)status.st_size < sizeof(PrimeIndexHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) return false;
+        mapping = mapped;
+        mappingBytes = status.st_size;
+        
+        header = (const PrimeIndexHeader*)mapping;
+        const char* base = (const char*)mapping;
+        words = (const uint64_t*)(base + header->wordsOffset);
+        ranks = (const uint64_t*)(base + header->ranksOffset);
+        if (!valid()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+    
+    void close() {
+        if (mapping) munmap(mapping, mappingBytes);
+        mapping = nullptr;
+        header = nullptr;
+    }
+    
+    bool isOpen() const { return mapping != nullptr; }
+    uint64_t limit() const { return header->limit; }
+    uint64_t primeCount() const { return header->primeCount; }
+    size_t fileBytes() const { return mappingBytes; }
+    
+    // True for primes <= limit
+    bool isPrime(uint64_t x) const {
+        if (x > header->limit) return false;
+        if (x < 7) return x == 2 || x == 3 || x == 5;
+        int k = wheelTables().residueIndex[x % WHEEL_SPAN];
+        return k >= 0 && (words[x / WORD_SPAN] >> (x / WHEEL_SPAN % 8 * 8 + k) & 1);
+    }
+    
+    // pi(x), the number of primes <= x, for x <= limit; larger x count up to limit
+    uint64_t rank(uint64_t x) const {
+        x = std::min(x, header->limit);
+        uint64_t small = (x >= 2) + (x >= 3) + (x >= 5);
+        if (x < 7) return small;
+        
+        uint64_t w = x / WORD_SPAN;
+        uint64_t first = w - w % PRIME_INDEX_BLOCK_WORDS;
+        uint64_t total = small + ranks[first / PRIME_INDEX_BLOCK_WORDS];
+        for (uint64_t i = first; i < w; i++) total += __builtin_popcountll(words[i]);
+        return total + __builtin_popcountll(words[w] & wheelWordBitsUpTo(x));
+    }
+    
+    // The k-th prime, counting select(1) = 2; 0 when k is 0 or above primeCount
+    uint64_t select(uint64_t k) const {
+        if (k == 0 || k > header->primeCount) return 0;
+        if (k <= 3) return k == 1 ? 2 : k == 2 ? 3 : 5;
+        k -= 3;
+        
+        // Last block whose rank is below k: the k-th wheel prime lies inside it
+        const uint64_t* end = ranks + header->wordCount / PRIME_INDEX_BLOCK_WORDS + 1;
+        uint64_t block = std::upper_bound(ranks, end, k - 1) - ranks - 1;
+        k -= ranks[block];
+        for (uint64_t w = block * PRIME_INDEX_BLOCK_WORDS;; w++) {
+            uint64_t word = words[w];
+            uint64_t bits = __builtin_popcountll(word);
+            if (k <= bits) {
+                while (--k > 0) word &= word - 1;
+                return w * WORD_SPAN + wheelTables().wordOffset[__builtin_ctzll(word)];
+            }
+            k -= bits;
+        }
+    }
+    
+    // Smallest prime >= x, or 0 if there is none <= limit
+    uint64_t nextPrime(uint64_t x) const {
+        for (uint64_t p : {2, 3, 5}) {
+            if (x <= p) return p <= header->limit ? p : 0;
+        }
+        uint64_t w = x / WORD_SPAN;
+        if (w >= header->wordCount) return 0;
+        uint64_t word = words[w];
+        if (x % WORD_SPAN != 0) word &= ~wheelWordBitsUpTo(x - 1);
+        while (word == 0) {
+            if (++w == header->wordCount) return 0;
+            word = words[w];
+        }
+        return w * WORD_SPAN + wheelTables().wordOffset[__builtin_ctzll(word)];
+    }
+    
+    // Largest prime <= x (x above limit is clamped to it), or 0 if x < 2
+    uint64_t prevPrime(uint64_t x) const {
+        x = std::min(x, header->limit);
+        if (x < 7) return x >= 5 ? 5 : x >= 3 ? 3 : x >= 2 ? 2 : 0;
+        uint64_t w = x / WORD_SPAN;
+        uint64_t word = words[w] & wheelWordBitsUpTo(x);
+        while (word == 0) {
+            if (w == 0) return 5;
+            word = words[--w];
+        }
+        return w * WORD_SPAN + wheelTables().wordOffset[63 - __builtin_clzll(word)];
+    }
+    
+private:
+    static const uint64_t WORD_SPAN = 8 * WHEEL_SPAN;
+    
+    void* mapping = nullptr;
+    size_t mappingBytes = 0;
+    const PrimeIndexHeader* header = nullptr;
+    const uint64_t* words = nullptr;
+    const uint64_t* ranks = nullptr;
+    
+    // Checks the header and that both arrays lie inside the file. Every field
+    // is bounded by the file size before it is scaled, so a corrupt header
+    // cannot wrap the arithmetic.
+    bool valid() const {
+        const PrimeIndexHeader& h = *header;
+        uint64_t blocks = h.wordCount / PRIME_INDEX_BLOCK_WORDS;
+        return std::memcmp(h.magic, PRIME_INDEX_MAGIC, sizeof(h.magic)) == 0 &&
+               h.version == PRIME_INDEX_VERSION && h.blockWords == PRIME_INDEX_BLOCK_WORDS &&
+               h.wordCount % PRIME_INDEX_BLOCK_WORDS == 0 && h.limit / WORD_SPAN < h.wordCount &&
+               h.wordsOffset % 8 == 0 && h.ranksOffset % 8 == 0 &&
+               h.wordsOffset <= mappingBytes && h.wordCount <= (mappingBytes - h.wordsOffset) / 8 &&
+               h.ranksOffset <= mappingBytes && blocks + 1 <= (mappingBytes - h.ranksOffset) / 8;
+    }
+};
+
+} // namespace number_elite
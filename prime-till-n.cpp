@@ -1,126 +1,9 @@
 #include <iostream>
 #include <vector>
-#include <cmath>
+#include <string>
+#include "trial-division.h"
 using namespace std;
-
-// Method 1: Simple Trial Division
-vector<int> primeTillNSimple(int n) {
-    vector<int> primes;
-    
-    for (int i = 2; i <= n; i++) {
-        bool isPrime = true;
-        
-        for (int j = 2; j <= sqrt(i); j++) {
-            if (i % j == 0) {
-                isPrime = false;
-                break;
-            }
-        }
-        
-        if (isPrime) {
-            primes.push_back(i);
-        }
-    }
-    
-    return primes;
-}
-
-// Method 2: Optimized Trial Division
-vector<int> primeTillNOptimized(int n) {
-    if (n < 2) return {};
-    
-    vector<int> primes;
-    primes.push_back(2); // First prime
-    
-    for (int i = 3; i <= n; i += 2) { // Check only odd numbers
-        bool isPrime = true;
-        
-        // Check divisibility only by primes found so far
-        for (int prime : primes) {
-            if (prime * prime > i) break; // Only check up to sqrt(i)
-            
-            if (i % prime == 0) {
-                isPrime = false;
-                break;
-            }
-        }
-        
-        if (isPrime) {
-            primes.push_back(i);
-        }
-    }
-    
-    return primes;
-}
-
-// Method 3: Simple Sieve (not the standard Sieve of Eratosthenes)
-vector<int> primeTillNSieve(int n) {
-    if (n < 2) return {};
-    
-    vector<bool> isPrime(n + 1, true);
-    vector<int> primes;
-    
-    isPrime[0] = isPrime[1] = false;
-    
-    for (int i = 2; i <= n; i++) {
-        if (isPrime[i]) {
-            primes.push_back(i);
-            
-            // Mark multiples as composite
-            for (int j = i * 2; j <= n; j += i) {
-                isPrime[j] = false;
-            }
-        }
-    }
-    
-    return primes;
-}
-
-// Method 4: Using 6k±1 optimization
-vector<int> primeTillN6kOptimization(int n) {
-    if (n < 2) return {};
-    
-    vector<int> primes;
-    
-    if (n >= 2) primes.push_back(2);
-    if (n >= 3) primes.push_back(3);
-    
-    // All primes > 3 are of the form 6k±1
-    for (int i = 5; i <= n; i += 6) {
-        // Check 6k-1
-        if (i <= n) {
-            bool isPrime = true;
-            for (int j = 5; j * j <= i; j += 6) {
-                if (i % j == 0 || i % (j + 2) == 0) {
-                    isPrime = false;
-                    break;
-                }
-            }
-            // Also check divisibility by 2 and 3
-            if (isPrime && i % 2 != 0 && i % 3 != 0) {
-                primes.push_back(i);
-            }
-        }
-        
-        // Check 6k+1
-        if (i + 2 <= n) {
-            bool isPrime = true;
-            int candidate = i + 2;
-            for (int j = 5; j * j <= candidate; j += 6) {
-                if (candidate % j == 0 || candidate % (j + 2) == 0) {
-                    isPrime = false;
-                    break;
-                }
-            }
-            // Also check divisibility by 2 and 3
-            if (isPrime && candidate % 2 != 0 && candidate % 3 != 0) {
-                primes.push_back(candidate);
-            }
-        }
-    }
-    
-    return primes;
-}
+using namespace number_elite;
 
 // Function to display primes
 void displayPrimes(const vector<int>& primes, const string& method) {
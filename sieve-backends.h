@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+#include "sieve.h"
+#include "parallel-sieve.h"
+
+namespace number_elite {
+
+// Every sieve behind one signature, so callers (and the dispatcher below) can
+// pick one at run time. A backend writes the primes <= n into primes;
+// threads is only used by the threaded ones.
+struct SieveBackend {
+    const char* name;
+    bool threaded;
+    void (*sieve)(uint32_t n, unsigned threads, std::vector<uint32_t>& primes);
+};
+
+const SieveBackend SIEVE_BACKENDS[] = {
+    {"basic", false, [](uint32_t n, unsigned, std::vector<uint32_t>& primes) {
+        primes = extractPrimes<uint32_t>(sieveOfEratosthenes(n));
+    }},
+    {"odd-only", false, [](uint32_t n, unsigned, std::vector<uint32_t>& primes) {
+        primes = extractPrimes<uint32_t>(optimizedSieve(n));
+    }},
+    {"linear", false, [](uint32_t n, unsigned, std::vector<uint32_t>& primes) {
+        primes = linearSieve(n);
+    }},
+    {"atkin", false, [](uint32_t n, unsigned, std::vector<uint32_t>& primes) {
+        primes = sieveOfAtkin(n);
+    }},
+    {"wheel-210", false, [](uint32_t n, unsigned, std::vector<uint32_t>& primes) {
+        primes = wheel210Sieve(n);
+    }},
+    {"segmented", false, [](uint32_t n, unsigned, std::vector<uint32_t>& primes) {
+        primes = segmentedSieve(n);
+    }},
+    {"parallel", true, [](uint32_t n, unsigned threads, std::vector<uint32_t>& primes) {
+        primes = parallelSegmentedSieve(n, threads);
+    }},
+};
+
+const size_t SIEVE_BACKEND_COUNT = sizeof(SIEVE_BACKENDS) / sizeof(SIEVE_BACKENDS[0]);
+
+// Size of the level-th data cache in bytes, with common sizes as fallbacks
+inline size_t dataCacheSize(int level) {
+    long size = -1;
+#if defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+    if (level == 2) size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (level == 3) size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+    if (level == 1) return l1DataCacheSize();
+    if (size > 0) return size;
+    return level == 2 ? 1 << 20 : 8 << 20;
+}
+
+// Measured cost of every backend, in nanoseconds per number sieved, at a few
+// sizes of n; a backend that fell too far behind at one size is not run at
+// the larger ones and has an infinite cost there
+struct SieveCalibration {
+    unsigned threads = 1;
+    std::vector<uint32_t> sizes;
+    std::vector<std::vector<double>> nanosPerNumber;   // [size][backend]
+};
+
+// Times every backend with the given thread count at the n whose one byte per
+// number fills L1, L2, L3 and four times L3, so the costs show where each
+// working set stops fitting in cache. Each size is repeated for at least a
+// few milliseconds and the fastest run is kept. The largest size is capped at
+// 2^26, which keeps a full calibration under a second or so.
+inline SieveCalibration calibrateSieveBackends(unsigned threads = 0) {
+    const double MIN_SECONDS = 0.005;
+    const double PRUNE_FACTOR = 8;
+    if (threads == 0) threads = defaultThreadCount();
+    
+    SieveCalibration calibration;
+    calibration.threads = threads;
+    for (size_t bytes : {dataCacheSize(1), dataCacheSize(2), dataCacheSize(3), 4 * dataCacheSize(3)}) {
+        uint32_t n = std::min<size_t>(std::max<size_t>(bytes, 1 << 12), 1 << 26);
+        if (calibration.sizes.empty() || n > calibration.sizes.back()) calibration.sizes.push_back(n);
+    }
+    
+    std::vector<bool> pruned(SIEVE_BACKEND_COUNT, false);
+    std::vector<uint32_t> primes;
+    for (uint32_t n : calibration.sizes) {
+        std::vector<double> costs(SIEVE_BACKEND_COUNT, std::numeric_limits<double>::infinity());
+        for (size_t b = 0; b < SIEVE_BACKEND_COUNT; b++) {
+            if (pruned[b]) continue;
+            double best = std::numeric_limits<double>::infinity(), total = 0;
+            do {
+                auto start = std::chrono::steady_clock::now();
+                SIEVE_BACKENDS[b].sieve(n, threads, primes);
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                best = std::min(best, seconds);
+                total += seconds;
+            } while (total < MIN_SECONDS);
+            costs[b] = best * 1e9 / n;
+        }
+        
+        double fastest = *std::min_element(costs.begin(), costs.end());
+        for (size_t b = 0; b < SIEVE_BACKEND_COUNT; b++) {
+            if (costs[b] > PRUNE_FACTOR * fastest) pruned[b] = true;
+        }
+        calibration.nanosPerNumber.push_back(costs);
+    }
+    return calibration;
+}
+
+// Index into SIEVE_BACKENDS of the fastest backend for n: the one measured
+// cheapest at the smallest calibrated size >= n, or at the largest size when
+// n is beyond all of them
+inline size_t selectSieveBackend(uint64_t n, const SieveCalibration& calibration) {
+    size_t s = std::lower_bound(calibration.sizes.begin(), calibration.sizes.end(), n) - calibration.sizes.begin();
+    const std::vector<double>& costs = calibration.nanosPerNumber[std::min(s, calibration.sizes.size() - 1)];
+    return std::min_element(costs.begin(), costs.end()) - costs.begin();
+}
+
+// Calibration for a thread count, measured on first use and kept for the
+// rest of the process
+inline const SieveCalibration& sieveCalibration(unsigned threads = 0) {
+    static std::mutex mutex;
+    static std::deque<SieveCalibration> calibrations;   // references stay valid as it grows
+    if (threads == 0) threads = defaultThreadCount();
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const SieveCalibration& calibration : calibrations) {
+        if (calibration.threads == threads) return calibration;
+    }
+    calibrations.push_back(calibrateSieveBackends(threads));
+    return calibrations.back();
+}
+
+// Primes <= n from whichever backend the calibration found fastest for n
+inline std::vector<uint32_t> autoSieve(uint32_t n, unsigned threads = 0) {
+    if (threads == 0) threads = defaultThreadCount();
+    std::vector<uint32_t> primes;
+    SIEVE_BACKENDS[selectSieveBackend(n, sieveCalibration(threads))].sieve(n, threads, primes);
+    return primes;
+}
+
+} // namespace number_elite
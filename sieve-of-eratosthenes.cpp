@@ -1,134 +1,67 @@
 #include <iostream>
+#include <iomanip>
 #include <vector>
+#include <string>
+#include <cstdint>
 #include <cmath>
-#include <algorithm>
+#include "sieve.h"
+#include "parallel-sieve.h"
+#include "prime-count.h"
+#include "sieve-backends.h"
 using namespace std;
+using namespace number_elite;
 
-// Basic Sieve of Eratosthenes
-vector<bool> sieveOfEratosthenes(int n) {
-    vector<bool> isPrime(n + 1, true);
-    isPrime[0] = isPrime[1] = false;
+// Checks the parallel sieve against the single-threaded basic sieve
+bool verifyParallelSieve(int n, unsigned threads) {
+    vector<int> expected = extractPrimes(sieveOfEratosthenes(n));
     
-    for (int i = 2; i * i <= n; i++) {
-        if (isPrime[i]) {
-            // Mark all multiples of i as composite
-            for (int j = i * i; j <= n; j += i) {
-                isPrime[j] = false;
-            }
-        }
-    }
+    vector<int> streamed;
+    parallelForEachPrime(n, [&](uint64_t p) { streamed.push_back(p); }, threads);
     
-    return isPrime;
+    return parallelSegmentedSieve(n, threads) == expected && streamed == expected &&
+           parallelCountPrimes(n, threads) == expected.size();
 }
 
-// Optimized Sieve of Eratosthenes (only odd numbers)
-vector<bool> optimizedSieve(int n) {
-    vector<bool> isPrime(n + 1, true);
-    isPrime[0] = isPrime[1] = false;
-    
-    // Handle 2 separately
-    if (n >= 2) {
-        // Mark all even numbers > 2 as composite
-        for (int i = 4; i <= n; i += 2) {
-            isPrime[i] = false;
-        }
-    }
-    
-    // Process odd numbers starting from 3
-    for (int i = 3; i * i <= n; i += 2) {
-        if (isPrime[i]) {
-            // Mark odd multiples of i starting from i^2
-            for (int j = i * i; j <= n; j += 2 * i) {
-                isPrime[j] = false;
-            }
-        }
-    }
-    
-    return isPrime;
-}
-
-// Segmented Sieve for large numbers
-vector<int> segmentedSieve(int n) {
-    int limit = sqrt(n) + 1;
-    vector<bool> primesUpToLimit = sieveOfEratosthenes(limit);
-    
-    // Get all primes up to sqrt(n)
-    vector<int> primes;
-    for (int i = 2; i <= limit; i++) {
-        if (primesUpToLimit[i]) {
-            primes.push_back(i);
-        }
-    }
-    
-    vector<int> result;
-    
-    // Add small primes to result
-    for (int prime : primes) {
-        if (prime <= n) {
-            result.push_back(prime);
-        }
-    }
-    
-    // Process segments
-    int segmentSize = max(limit, 1);
-    
-    for (int low = limit + 1; low <= n; low += segmentSize) {
-        int high = min(low + segmentSize - 1, n);
-        vector<bool> segment(high - low + 1, true);
-        
-        // Mark multiples in current segment
-        for (int prime : primes) {
-            // Find first multiple of prime in segment
-            int start = max(prime * prime, (low + prime - 1) / prime * prime);
-            
-            for (int j = start; j <= high; j += prime) {
-                segment[j - low] = false;
-            }
-        }
-        
-        // Add primes from current segment
-        for (int i = 0; i < segment.size(); i++) {
-            if (segment[i]) {
-                result.push_back(low + i);
-            }
+// Checks nthPrime against the linear sieve for every k up to 100 and about a
+// thousand k spread over pi(n)
+bool verifyNthPrime(int n) {
+    vector<int> primes = linearSieve(n);
+    size_t stride = primes.size() / 1000 + 1;
+    for (size_t k = 1; k <= primes.size(); k += k < 100 ? 1 : stride) {
+        if (nthPrime(k) != (uint64_t)primes[k - 1]) {
+            cout << "Mismatch at k = " << k << endl;
+            return false;
         }
     }
-    
-    return result;
+    return true;
 }
 
-// Linear Sieve (Sieve of Euler)
-vector<int> linearSieve(int n) {
-    vector<bool> isPrime(n + 1, true);
-    vector<int> primes;
-    
-    isPrime[0] = isPrime[1] = false;
-    
-    for (int i = 2; i <= n; i++) {
-        if (isPrime[i]) {
-            primes.push_back(i);
-        }
-        
-        for (int j = 0; j < primes.size() && i * primes[j] <= n; j++) {
-            isPrime[i * primes[j]] = false;
-            if (i % primes[j] == 0) {
-                break; // Key optimization: avoid marking same number multiple times
-            }
+// Checks a LazySieve against the packed bitset over a stream of queries that
+// grows towards n: isPrime, pi(x) and the primes of a short range below x.
+// Then a single segment far larger than the square root of its end, whose base
+// primes past 2^16 must come from its earlier, finished segments.
+bool verifyLazySieve(int n) {
+    PrimeBitset expected(n);
+    LazySieve lazy;
+    for (int i = 1; i <= 1000; i++) {
+        uint64_t x = (uint64_t)n * i / 1000;
+        uint64_t lo = x > 1000 ? x - 1000 : 0;
+        vector<uint64_t> range(expected.count(lo, x));
+        expected.extract(lo, x, range.data(), range.size());
+        if (lazy.isPrime(x) != expected.isPrime(x) || lazy.primeCount(x) != expected.count(0, x) ||
+            lazy.primesInRange(lo, x) != range) {
+            cout << "Mismatch at x = " << x << endl;
+            return false;
         }
     }
     
-    return primes;
-}
-
-// Function to extract primes from boolean array
-vector<int> extractPrimes(const vector<bool>& isPrime) {
-    vector<int> primes;
-    for (int i = 0; i < isPrime.size(); i++) {
-        if (isPrime[i]) {
-            primes.push_back(i);
-        }
+    uint64_t x = 10000000000ull + 1000;
+    LazySieve wide(1 << 28);
+    if (wide.primeCount(x) != primeCount(x)) {
+        cout << "Mismatch at x = " << x << " with 2^28-byte segments" << endl;
+        return false;
     }
-    return primes;
+    return true;
 }
 
 // Function to display primes
@@ -161,6 +94,39 @@ void displayPrimes(const vector<int>& primes, const string& method, int displayL
     }
 }
 
+// Same report for a bitset: only the count and the sampled primes are decoded
+void displayPrimes(const PrimeBitset& primes, const string& method) {
+    uint64_t n = primes.limit();
+    uint64_t total = primes.count(0, n);
+    cout << "\n=== " << method << " ===" << endl;
+    cout << "Found " << total << " primes using " << primes.memoryBytes() / 1024 << " KB" << endl;
+    
+    vector<uint64_t> first(min<uint64_t>(total, 50));
+    primes.extract(0, n, first.data(), first.size());
+    cout << "First " << first.size() << " primes: ";
+    for (size_t i = 0; i < first.size(); i++) {
+        cout << first[i];
+        if (i + 1 < first.size()) cout << ", ";
+        if ((i + 1) % 10 == 0 && i + 1 < first.size()) cout << endl << "                 "; // Indent continuation
+    }
+    cout << endl;
+    
+    // Widen a window below n until it holds the last 10 primes
+    uint64_t want = min<uint64_t>(total, 10), lo = n, step = 64;
+    while (lo > 0 && primes.count(lo, n) < want) {
+        lo -= min(lo, step);
+        step *= 2;
+    }
+    vector<uint64_t> tail(primes.count(lo, n));
+    primes.extract(lo, n, tail.data(), tail.size());
+    cout << "Last " << want << " primes: ";
+    for (size_t i = tail.size() - want; i < tail.size(); i++) {
+        cout << tail[i];
+        if (i + 1 < tail.size()) cout << ", ";
+    }
+    cout << endl;
+}
+
 // Performance comparison function
 void performanceTest(int n) {
     cout << "\n=== Performance Test for n = " << n << " ===" << endl;
@@ -183,8 +149,22 @@ void performanceTest(int n) {
     vector<int> primes4 = segmentedSieve(n);
     cout << "Segmented Sieve: " << primes4.size() << " primes found" << endl;
     
+    // Test the packed bitset sieve (count only)
+    PrimeBitset bitset(n);
+    uint64_t countBits = bitset.count(0, n);
+    cout << "Packed Bitset Sieve: " << countBits << " primes found in " << bitset.memoryBytes() / 1024 << " KB" << endl;
+    
+    // Test parallel segmented sieve (count only)
+    uint64_t count5 = parallelCountPrimes(n);
+    cout << "Parallel Segmented Sieve (" << defaultThreadCount() << " threads): " << count5 << " primes found" << endl;
+    
+    // Test the prime counting function (no sieve array at all)
+    uint64_t count6 = primeCount(n);
+    cout << "Prime Counting pi(n): " << count6 << " primes found" << endl;
+    
     // Verify results match
-    if (primes1.size() == primes2.size() && primes2.size() == primes3.size() && primes3.size() == primes4.size()) {
+    if (primes1.size() == primes2.size() && primes2.size() == primes3.size() && primes3.size() == primes4.size() &&
+        primes4.size() == countBits && countBits == count5 && count5 == count6) {
         cout << "✓ All methods found the same number of primes" << endl;
     } else {
         cout << "✗ Methods found different numbers of primes!" << endl;
@@ -210,6 +190,14 @@ int main() {
     cout << "4. Segmented Sieve" << endl;
     cout << "5. Compare all methods" << endl;
     cout << "6. Performance test" << endl;
+    cout << "7. Parallel Segmented Sieve" << endl;
+    cout << "8. Primes in a 64-bit window [lo, hi]" << endl;
+    cout << "9. Prime counting function pi(x)" << endl;
+    cout << "10. Next/previous primes from a 64-bit start" << endl;
+    cout << "11. Packed bitset sieve (count and range queries)" << endl;
+    cout << "12. The k-th prime" << endl;
+    cout << "13. Automatic backend (calibrated on this machine)" << endl;
+    cout << "14. Lazy sieve (grows with the queries)" << endl;
     
     cout << "Enter choice: ";
     cin >> choice;
@@ -266,6 +254,137 @@ int main() {
             performanceTest(n);
             break;
         }
+        case 7: {
+            unsigned threads;
+            cout << "Enter number of threads (0 = all cores): ";
+            cin >> threads;
+            
+            vector<int> primes = parallelSegmentedSieve(n, threads);
+            displayPrimes(primes, "Parallel Segmented Sieve");
+            
+            if (verifyParallelSieve(n, threads)) {
+                cout << "\n✓ Parallel sieve matches the single-threaded sieve!" << endl;
+            } else {
+                cout << "\n✗ Parallel sieve differs from the single-threaded sieve!" << endl;
+            }
+            break;
+        }
+        case 8: {
+            uint64_t lo, hi;
+            cout << "Enter lo and hi (up to 18446744073709551615): ";
+            cin >> lo >> hi;
+            
+            vector<uint64_t> primes = primesInRange(lo, hi);
+            cout << "\n=== Primes in [" << lo << ", " << hi << "] ===" << endl;
+            cout << "Found " << primes.size() << " primes" << endl;
+            for (size_t i = 0; i < primes.size() && i < 20; i++) {
+                cout << primes[i] << endl;
+            }
+            if (primes.size() > 20) cout << "..." << endl << primes.back() << endl;
+            break;
+        }
+        case 9: {
+            uint64_t x;
+            unsigned threads;
+            cout << "Enter x: ";
+            cin >> x;
+            cout << "Enter number of threads (0 = all cores): ";
+            cin >> threads;
+            if (x >= 1ull << 63) {
+                cout << "x must be below 2^63!" << endl;
+                break;
+            }
+            
+            cout << "\npi(" << x << ") = " << primeCount(x, threads) << endl;
+            break;
+        }
+        case 10: {
+            uint64_t start;
+            int count;
+            cout << "Enter start and how many primes to step: ";
+            cin >> start >> count;
+            
+            PrimeIterator forward(start), backward(start);
+            cout << "\n=== Primes after " << start << " ===" << endl;
+            for (int i = 0; i < count; i++) {
+                uint64_t p = forward.nextPrime();
+                if (p == 0) break;
+                cout << p << endl;
+            }
+            cout << "\n=== Primes before " << start << " ===" << endl;
+            for (int i = 0; i < count; i++) {
+                uint64_t p = backward.prevPrime();
+                if (p == 0) break;
+                cout << p << endl;
+            }
+            break;
+        }
+        case 11: {
+            PrimeBitset primes(n);
+            displayPrimes(primes, "Packed Bitset Sieve");
+            
+            uint64_t lo, hi;
+            cout << "\nEnter a range [lo, hi] to count: ";
+            cin >> lo >> hi;
+            cout << "Primes in [" << lo << ", " << hi << "]: " << primes.count(lo, hi) << endl;
+            break;
+        }
+        case 12: {
+            uint64_t k;
+            cout << "Enter k: ";
+            cin >> k;
+            
+            cout << "\nThe " << k << "-th prime is " << nthPrime(k) << endl;
+            if (verifyNthPrime(n)) {
+                cout << "✓ nthPrime matches the linear sieve for the primes up to " << n << endl;
+            } else {
+                cout << "✗ nthPrime differs from the linear sieve!" << endl;
+            }
+            break;
+        }
+        case 13: {
+            unsigned threads;
+            cout << "Enter number of threads (0 = all cores): ";
+            cin >> threads;
+            
+            const SieveCalibration& calibration = sieveCalibration(threads);
+            cout << "\n=== Calibration (ns per number, " << calibration.threads << " threads) ===" << endl;
+            cout << setw(12) << "n";
+            for (const SieveBackend& backend : SIEVE_BACKENDS) cout << setw(11) << backend.name;
+            cout << endl;
+            for (size_t s = 0; s < calibration.sizes.size(); s++) {
+                cout << setw(12) << calibration.sizes[s];
+                for (double cost : calibration.nanosPerNumber[s]) {
+                    if (isinf(cost)) {
+                        cout << setw(11) << "-";
+                    } else {
+                        cout << setw(11) << fixed << setprecision(3) << cost;
+                    }
+                }
+                cout << endl;
+            }
+            
+            const SieveBackend& backend = SIEVE_BACKENDS[selectSieveBackend(n, calibration)];
+            vector<uint32_t> found = autoSieve(n, threads);
+            displayPrimes(vector<int>(found.begin(), found.end()), string("Automatic: ") + backend.name);
+            break;
+        }
+        case 14: {
+            LazySieve lazy;
+            uint64_t x;
+            cout << "Enter numbers x (0 to stop); each is answered from the sieve, extended only past what earlier ones covered:" << endl;
+            while (cin >> x && x != 0) {
+                cout << "  isPrime(" << x << ") = " << lazy.isPrime(x) << ", pi(" << x << ") = " << lazy.primeCount(x)
+                     << ", sieved below " << lazy.limit() << " (" << lazy.memoryBytes() / 1024 << " KB)" << endl;
+            }
+            
+            if (verifyLazySieve(n)) {
+                cout << "✓ LazySieve matches the bitset sieve over a growing query stream up to " << n << endl;
+            } else {
+                cout << "✗ LazySieve differs from the bitset sieve!" << endl;
+            }
+            break;
+        }
         default:
             cout << "Invalid choice!" << endl;
     }
@@ -0,0 +1,1148 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <unistd.h>
+#include "small-primes.h"
+
+namespace number_elite {
+
+// All sieves are templated on the integer type of their bound (int, uint32_t,
+// uint64_t, ...). Loops compare i <= n / i instead of i * i <= n and stop a
+// stride before n instead of stepping past it, so nothing overflows even when
+// n is the largest value of the type.
+
+// Basic Sieve of Eratosthenes
+template <typename T>
+std::vector<bool> sieveOfEratosthenes(T n) {
+    static_assert(std::is_integral<T>::value, "sieve bound must be an integer type");
+    std::vector<bool> isPrime((size_t)n + 1, true);
+    isPrime[0] = false;
+    if (n >= 1) isPrime[1] = false;
+    
+    for (T i = 2; i <= n / i; i++) {
+        if (isPrime[i]) {
+            // Mark all multiples of i as composite
+            for (T j = i * i;; j += i) {
+                isPrime[j] = false;
+                if (n - j < i) break;
+            }
+        }
+    }
+    
+    return isPrime;
+}
+
+// Optimized Sieve of Eratosthenes (only odd numbers)
+template <typename T>
+std::vector<bool> optimizedSieve(T n) {
+    static_assert(std::is_integral<T>::value, "sieve bound must be an integer type");
+    std::vector<bool> isPrime((size_t)n + 1, true);
+    isPrime[0] = false;
+    if (n >= 1) isPrime[1] = false;
+    
+    // Handle 2 separately
+    if (n >= 4) {
+        // Mark all even numbers > 2 as composite
+        for (T i = 4;; i += 2) {
+            isPrime[i] = false;
+            if (n - i < 2) break;
+        }
+    }
+    
+    // Process odd numbers starting from 3
+    for (T i = 3; i <= n / i; i += 2) {
+        if (isPrime[i]) {
+            // Mark odd multiples of i starting from i^2
+            for (T j = i * i;; j += 2 * i) {
+                isPrime[j] = false;
+                if (n - j < 2 * i) break;
+            }
+        }
+    }
+    
+    return isPrime;
+}
+
+// ---- Wheel-factorized segmented sieve engine ----
+
+// Mod-30 wheel: each byte of a segment covers 30 consecutive integers, one bit
+// per residue coprime to 30, so multiples of 2, 3 and 5 are never stored
+const int WHEEL_SPAN = 30;
+const uint8_t WHEEL_RESIDUES[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+const uint8_t WHEEL_GAPS[8] = {6, 4, 2, 4, 2, 4, 6, 2};
+
+// Primes 7, 11 and 13 are pre-sieved by copying a pattern that repeats every
+// 7 * 11 * 13 bytes instead of being crossed off in every segment
+const size_t PRESIEVE_BYTES = 7 * 11 * 13;
+
+// Lookup tables for crossing off p * q while the multiplier q walks the wheel.
+// With p = 30a + r and q = 30b + s, p * q lives in byte a*q + floor(r*q / 30),
+// so stepping q by a wheel gap advances the byte by a * gap + byteCarry[r][s].
+struct WheelTables {
+    int8_t residueIndex[WHEEL_SPAN];
+    uint8_t byteCarry[8][8];
+    uint8_t clearMask[8][8];
+    uint8_t wordOffset[64];
+    uint8_t nextResidueGap[WHEEL_SPAN];
+    uint8_t residuesUpTo[WHEEL_SPAN];
+    uint8_t presieve[PRESIEVE_BYTES];
+    
+    WheelTables() {
+        for (int i = 0; i < WHEEL_SPAN; i++) residueIndex[i] = -1;
+        for (int k = 0; k < 8; k++) residueIndex[WHEEL_RESIDUES[k]] = k;
+        for (int i = 0; i < WHEEL_SPAN; i++) {
+            int gap = 0;
+            while (residueIndex[(i + gap) % WHEEL_SPAN] < 0) gap++;
+            nextResidueGap[i] = gap;
+        }
+        
+        // Bits of a wheel byte whose residue is at most i
+        for (int i = 0; i < WHEEL_SPAN; i++) {
+            residuesUpTo[i] = 0;
+            for (int k = 0; k < 8; k++) {
+                if (WHEEL_RESIDUES[k] <= i) residuesUpTo[i] |= 1u << k;
+            }
+        }
+        
+        for (int r = 0; r < 8; r++) {
+            for (int s = 0; s < 8; s++) {
+                int pr = WHEEL_RESIDUES[r], qs = WHEEL_RESIDUES[s];
+                byteCarry[r][s] = pr * (qs + WHEEL_GAPS[s]) / WHEEL_SPAN - pr * qs / WHEEL_SPAN;
+                clearMask[r][s] = ~(1u << residueIndex[pr * qs % WHEEL_SPAN]);
+            }
+        }
+        
+        // Value offset of bit k inside a 64-bit word of 8 wheel bytes
+        for (int k = 0; k < 64; k++) {
+            wordOffset[k] = WHEEL_SPAN * (k / 8) + WHEEL_RESIDUES[k % 8];
+        }
+        
+        for (size_t i = 0; i < PRESIEVE_BYTES; i++) {
+            presieve[i] = 0xFF;
+            for (int k = 0; k < 8; k++) {
+                size_t value = WHEEL_SPAN * i + WHEEL_RESIDUES[k];
+                if (value % 7 == 0 || value % 11 == 0 || value % 13 == 0) {
+                    presieve[i] &= ~(1u << k);
+                }
+            }
+        }
+    }
+};
+
+inline const WheelTables& wheelTables() {
+    static const WheelTables tables;
+    return tables;
+}
+
+// Size of the L1 data cache, which bounds the segment so crossing off stays in cache
+inline size_t l1DataCacheSize() {
+    // Read once: sysconf runs cpuid, which costs tens of microseconds under a
+    // hypervisor, more than sieving a small n
+    static const size_t size = [] {
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+        long size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+        if (size > 0) return (size_t)size;
+#endif
+        return (size_t)32 * 1024;
+    }();
+    return size;
+}
+
+// A sieving prime p = 30 * quotient + WHEEL_RESIDUES[primeIndex] together with
+// the position of its next multiple, carried from one segment to the next
+struct SievingPrime {
+    uint32_t quotient;
+    uint8_t primeIndex;
+    uint8_t wheelIndex;   // wheel index of the multiplier of the next multiple
+    uint64_t nextByte;    // absolute byte index of the next multiple
+};
+
+// Fills the wheel bytes [lowByte, lowByte + bytes) at data from the 7/11/13
+// pattern, fixing up the first byte
+inline void presieveWheelBytes(uint8_t* data, uint64_t lowByte, size_t bytes) {
+    const uint8_t* pattern = wheelTables().presieve;
+    size_t offset = lowByte % PRESIEVE_BYTES;
+    for (size_t i = 0; i < bytes;) {
+        size_t chunk = std::min(bytes - i, PRESIEVE_BYTES - offset);
+        std::memcpy(data + i, pattern + offset, chunk);
+        i += chunk;
+        offset = 0;
+    }
+    if (lowByte == 0) {
+        // 1 is not prime, while 7, 11 and 13 were crossed off by their own pattern
+        data[0] = (data[0] & ~1u) | 0x0E;
+    }
+}
+
+// Crosses off the multiples of one sieving prime inside the wheel bytes
+// [lowByte, lowByte + bytes) at data, leaving sp at its first multiple past them
+inline void crossOffWheelMultiples(SievingPrime& sp, uint8_t* data, uint64_t lowByte, size_t bytes) {
+    if (sp.nextByte >= lowByte + bytes) return;
+    
+    const WheelTables& tables = wheelTables();
+    const uint8_t* carry = tables.byteCarry[sp.primeIndex];
+    const uint8_t* mask = tables.clearMask[sp.primeIndex];
+    uint64_t a = sp.quotient;
+    uint64_t i = sp.nextByte - lowByte;
+    unsigned s = sp.wheelIndex;
+    
+    // Eight wheel steps always advance by exactly p bytes, so whole turns of
+    // the wheel can be unrolled with fixed offsets
+    uint64_t step[8];
+    for (int k = 0; k < 8; k++) {
+        unsigned w = (s + k) & 7;
+        step[k] = a * WHEEL_GAPS[w] + carry[w];
+    }
+    uint64_t offset[8];
+    offset[0] = 0;
+    for (int k = 1; k < 8; k++) offset[k] = offset[k - 1] + step[k - 1];
+    uint64_t p = offset[7] + step[7];
+    
+    if (i + offset[7] < bytes) {
+        uint8_t m[8];
+        for (int k = 0; k < 8; k++) m[k] = mask[(s + k) & 7];
+        for (; i + offset[7] < bytes; i += p) {
+            data[i] &= m[0];
+            data[i + offset[1]] &= m[1];
+            data[i + offset[2]] &= m[2];
+            data[i + offset[3]] &= m[3];
+            data[i + offset[4]] &= m[4];
+            data[i + offset[5]] &= m[5];
+            data[i + offset[6]] &= m[6];
+            data[i + offset[7]] &= m[7];
+        }
+    }
+    
+    while (i < bytes) {
+        data[i] &= mask[s];
+        i += a * WHEEL_GAPS[s] + carry[s];
+        s = (s + 1) & 7;
+    }
+    
+    sp.nextByte = lowByte + i;
+    sp.wheelIndex = s;
+}
+
+// Sieving state for prime p >= 7 in a sieve starting at wheel byte lowByte:
+// its first multiple p * q there with q >= p on the wheel
+inline SievingPrime wheelSievingPrime(uint64_t p, uint64_t lowByte) {
+    const WheelTables& tables = wheelTables();
+    uint64_t lowValue = WHEEL_SPAN * lowByte;
+    uint64_t q = std::max(p, lowValue / p + (lowValue % p != 0));
+    q += tables.nextResidueGap[q % WHEEL_SPAN];
+    return {(uint32_t)(p / WHEEL_SPAN), (uint8_t)tables.residueIndex[p % WHEEL_SPAN],
+            (uint8_t)tables.residueIndex[q % WHEEL_SPAN], (uint64_t)((unsigned __int128)p * q / WHEEL_SPAN)};
+}
+
+// Largest r with r * r <= n, exact over the whole 64-bit range
+inline uint64_t integerSqrt(uint64_t n) {
+    uint64_t r = std::min<uint64_t>(std::sqrt((double)n), UINT32_MAX);
+    while (r * r > n) r--;
+    while (r < UINT32_MAX && (r + 1) * (r + 1) <= n) r++;
+    return r;
+}
+
+// Upper bound on pi(x), the number of primes <= x: x / (ln x - 1.1) holds
+// from x = 60184 on (Dusart), and the slack covers the smaller x. Results are
+// reserved to this size so filling them never reallocates.
+inline uint64_t primeCountUpperBound(uint64_t x) {
+    if (x < 2) return 0;
+    return x / std::max(std::log((double)x) - 1.1, 1.0) + 16;
+}
+
+// Sieving primes 17 <= p <= sqrt(n); 2, 3 and 5 are off the wheel and
+// 7, 11 and 13 are handled by the pre-sieve pattern
+inline std::pmr::vector<uint32_t> wheelBasePrimes(uint64_t n,
+                                                  std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Frees a buffer taken from a memory resource
+struct ResourceDeleter {
+    std::pmr::memory_resource* resource;
+    size_t bytes;
+    
+    void operator()(uint8_t* p) const { resource->deallocate(p, bytes, 8); }
+};
+
+// Segmented sieve over the mod-30 wheel. One cache-sized byte buffer is reused
+// for every segment, and each sieving prime keeps its next-multiple offset so
+// starting points are never recomputed with a division. The segment, the
+// sieving primes and the base primes it builds itself all come from the given
+// memory resource, so with an Arena a sieve makes no heap allocations.
+class WheelSieve {
+public:
+    explicit WheelSieve(uint64_t n, size_t segmentBytes = l1DataCacheSize(),
+                        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : WheelSieve(n, 0, n / WHEEL_SPAN + 1,
+                     std::allocate_shared<std::pmr::vector<uint32_t>>(std::pmr::polymorphic_allocator<char>(resource),
+                                                                      wheelBasePrimes(n, resource)),
+                     segmentBytes, resource) {}
+    
+    // Sieves only the wheel bytes [firstByte, lastByte) of [0, n], i.e. the values
+    // in [30 * firstByte, 30 * lastByte), with base primes shared between windows
+    WheelSieve(uint64_t n, uint64_t firstByte, uint64_t lastByte,
+               std::shared_ptr<const std::pmr::vector<uint32_t>> basePrimes,
+               size_t segmentBytes = l1DataCacheSize(),
+               std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : n(n), firstByte(firstByte), lastByte(std::min(lastByte, n / WHEEL_SPAN + 1)),
+          segmentBytes(clampSegmentBytes(segmentBytes, this->lastByte - std::min(firstByte, this->lastByte))),
+          basePrimes(std::move(basePrimes)), resource(resource),
+          segment(nullptr, ResourceDeleter{resource, this->segmentBytes}), sievingPrimes(resource) {}
+    
+    // Calls callback(p) for every prime p <= n in increasing order
+    template <typename Callback>
+    void forEachPrime(Callback callback) {
+        restart();
+        while (sieveNextSegment()) extractSegment(callback);
+    }
+    
+    // Number of primes <= n, counted with popcount instead of extracting them
+    uint64_t countPrimes() {
+        uint64_t count = 0;
+        restart();
+        while (sieveNextSegment()) {
+            if (segmentLowByte == 0) count += smallPrimesUpTo(n);
+            const uint8_t* data = segment.get();
+            for (size_t i = 0; i < segmentLength; i += 8) {
+                uint64_t word;
+                std::memcpy(&word, data + i, 8);
+                count += __builtin_popcountll(word);
+            }
+        }
+        return count;
+    }
+    
+    // Calls visit(lowByte, data, bytes) with the raw wheel bytes of every
+    // sieved segment; bytes is padded with zeros to a multiple of 8
+    template <typename Visit>
+    void forEachSegment(Visit visit) {
+        restart();
+        while (sieveNextSegment()) visit(segmentLowByte, (const uint8_t*)segment.get(), segmentLength);
+    }
+    
+    // Pull interface: replaces primes with those of the next segment of the
+    // window and returns false once the window is exhausted. Sieving state is
+    // carried over, so consecutive calls never recompute first multiples.
+    bool nextSegmentPrimes(std::vector<uint64_t>& primes) {
+        if (!started) restart();
+        primes.clear();
+        if (!sieveNextSegment()) return false;
+        extractSegment([&](uint64_t p) { primes.push_back(p); });
+        return true;
+    }
+    
+    // First wheel byte not sieved yet; the last segment ends just before it
+    uint64_t nextByte() const { return nextLowByte; }
+    
+private:
+    uint64_t n;
+    uint64_t firstByte, lastByte;
+    size_t segmentBytes;
+    std::shared_ptr<const std::pmr::vector<uint32_t>> basePrimes;
+    std::pmr::memory_resource* resource;
+    std::unique_ptr<uint8_t[], ResourceDeleter> segment;
+    std::pmr::vector<SievingPrime> sievingPrimes;
+    
+    bool started = false;
+    size_t nextBase = 0;
+    uint64_t nextLowByte = 0;
+    uint64_t segmentLowByte = 0;
+    size_t segmentLength = 0;
+    
+    // 2, 3 and 5 are not on the wheel and are reported with the first segment
+    static uint64_t smallPrimesUpTo(uint64_t n) {
+        return (n >= 2) + (n >= 3) + (n >= 5);
+    }
+    
+    // A multiple of 8 of at least 64 bytes, and no larger than the window needs
+    static size_t clampSegmentBytes(size_t segmentBytes, uint64_t windowBytes) {
+        return std::max<size_t>(std::min<uint64_t>(segmentBytes, (windowBytes + 7) / 8 * 8) / 8 * 8, 64);
+    }
+    
+    // The buffer is allocated on first use and kept; every segment overwrites
+    // the bytes it uses
+    void restart() {
+        if (!segment) segment.reset((uint8_t*)resource->allocate(segmentBytes, 8));
+        sievingPrimes.clear();
+        nextBase = 0;
+        nextLowByte = firstByte;
+        started = true;
+    }
+    
+    // Calls callback(p) for every prime left in the sieved segment
+    template <typename Callback>
+    void extractSegment(Callback&& callback) {
+        if (segmentLowByte == 0) {
+            for (uint64_t p : {2, 3, 5}) {
+                if (p <= n) callback(p);
+            }
+        }
+        
+        const WheelTables& tables = wheelTables();
+        const uint8_t* data = segment.get();
+        for (size_t i = 0; i < segmentLength; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            uint64_t base = WHEEL_SPAN * (segmentLowByte + i);
+            while (word) {
+                callback(base + tables.wordOffset[__builtin_ctzll(word)]);
+                word &= word - 1;
+            }
+        }
+    }
+    
+    // Sieves the next segment of the window into the buffer; false when done
+    bool sieveNextSegment() {
+        if (nextLowByte >= lastByte) return false;
+        
+        const std::pmr::vector<uint32_t>& primes = *basePrimes;
+        uint64_t totalBytes = n / WHEEL_SPAN + 1;
+        uint64_t lowByte = nextLowByte;
+        uint64_t highByte = std::min<uint64_t>(lowByte + segmentBytes, lastByte);
+        nextLowByte = highByte;
+        
+        // Activate base primes whose square falls inside this segment. Only the
+        // first segment of a window needs a division to find the first multiple,
+        // and primes with no multiple left in the window are never stored.
+        while (nextBase < primes.size() &&
+               (uint64_t)primes[nextBase] * primes[nextBase] / WHEEL_SPAN < highByte) {
+            SievingPrime sp = wheelSievingPrime(primes[nextBase++], lowByte);
+            if (sp.nextByte < lastByte) sievingPrimes.push_back(sp);
+        }
+        
+        size_t bytes = highByte - lowByte;
+        presieveWheelBytes(segment.get(), lowByte, bytes);
+        for (SievingPrime& sp : sievingPrimes) {
+            crossOffWheelMultiples(sp, segment.get(), lowByte, bytes);
+        }
+        
+        // Drop wheel positions past n in the final segment
+        if (highByte == totalBytes) {
+            uint8_t& last = segment[bytes - 1];
+            for (int k = 0; k < 8; k++) {
+                if (WHEEL_RESIDUES[k] > n % WHEEL_SPAN) {
+                    last &= ~(1u << k);
+                }
+            }
+        }
+        if (bytes % 8 != 0) {
+            size_t padded = (bytes + 7) / 8 * 8;
+            std::fill(segment.get() + bytes, segment.get() + padded, 0);
+            bytes = padded;
+        }
+        
+        segmentLowByte = lowByte;
+        segmentLength = bytes;
+        return true;
+    }
+};
+
+inline std::pmr::vector<uint32_t> wheelBasePrimes(uint64_t n, std::pmr::memory_resource* resource) {
+    uint64_t limit = integerSqrt(n);
+    std::pmr::vector<uint32_t> basePrimes(resource);
+    basePrimes.reserve(primeCountUpperBound(limit));
+    if (limit < SMALL_PRIME_LIMIT) {
+        // n below 2^32: copied from the compile-time table, nothing is sieved
+        for (uint32_t p : SMALL_PRIMES.primes) {
+            if (p > limit) break;
+            if (p >= 17) basePrimes.push_back(p);
+        }
+        return basePrimes;
+    }
+    
+    WheelSieve(limit, l1DataCacheSize(), resource).forEachPrime([&](uint64_t p) {
+        if (p >= 17) basePrimes.push_back(p);
+    });
+    return basePrimes;
+}
+
+// Appends the primes <= n to primes, using resource for the sieve's buffers
+template <typename T, typename Primes>
+void segmentedSieveInto(T n, Primes& primes, std::pmr::memory_resource* resource) {
+    if (n < 2) return;
+    primes.reserve(primes.size() + primeCountUpperBound(n));
+    WheelSieve(n, l1DataCacheSize(), resource).forEachPrime([&](uint64_t p) { primes.push_back(p); });
+}
+
+// Segmented Sieve for large numbers, backed by the wheel engine
+template <typename T>
+std::vector<T> segmentedSieve(T n) {
+    std::vector<T> result;
+    segmentedSieveInto(n, result, std::pmr::get_default_resource());
+    return result;
+}
+
+// The same with every buffer, the result included, taken from resource
+template <typename T>
+std::pmr::vector<T> segmentedSieve(T n, std::pmr::memory_resource* resource) {
+    std::pmr::vector<T> result(resource);
+    segmentedSieveInto(n, result, resource);
+    return result;
+}
+
+// Calls callback(p) for every prime p in [lo, hi]. hi may be anything up to
+// 2^64 - 1; only the wheel bytes of the window are sieved.
+template <typename T, typename Callback>
+void sieveRange(T lo, T hi, Callback callback) {
+    static_assert(std::is_integral<T>::value, "sieve bounds must be an integer type");
+    if (hi < 2 || lo > hi) return;
+    
+    uint64_t low = std::max<T>(lo, 0), high = hi;
+    auto basePrimes = std::make_shared<const std::pmr::vector<uint32_t>>(wheelBasePrimes(high));
+    WheelSieve(high, low / WHEEL_SPAN, high / WHEEL_SPAN + 1, basePrimes).forEachPrime([&](uint64_t p) {
+        if (p >= low) callback((T)p);
+    });
+}
+
+// Primes in the window [lo, hi]
+template <typename T>
+std::vector<T> primesInRange(T lo, T hi) {
+    std::vector<T> primes;
+    sieveRange(lo, hi, [&](T p) { primes.push_back(p); });
+    return primes;
+}
+
+// Wheel bytes needed to cover every value up to 2^64 - 1
+const uint64_t WHEEL_BYTES_64 = UINT64_MAX / WHEEL_SPAN + 1;
+
+// Iterator windows: forward windows are capped because every sieving prime
+// with a multiple in the window is stored, backward steps buffer a whole
+// window of primes and are kept shorter still
+const uint64_t FORWARD_WINDOW_BYTES = 1 << 22;
+const uint64_t BACKWARD_WINDOW_BYTES = 1 << 20;
+
+// Streaming access to the primes around any 64-bit start. Only one segment,
+// the primes found in it and the base primes are held at a time: walking
+// forwards keeps one WheelSieve alive across segments, walking backwards
+// sieves short windows below the current one. Both directions return 0 once
+// they run off the end of the 64-bit range.
+class PrimeIterator {
+public:
+    explicit PrimeIterator(uint64_t start = 0, size_t segmentBytes = l1DataCacheSize())
+        : segmentBytes(segmentBytes) {
+        jumpTo(start);
+    }
+    
+    // Repositions the iterator; base primes already generated are kept
+    void jumpTo(uint64_t start) {
+        this->start = start;
+        positioned = false;
+        primes.clear();
+        forwardSieve.reset();
+    }
+    
+    // Smallest prime >= start on the first call, then the prime after the last one
+    uint64_t nextPrime() {
+        if (!positioned) position(true);
+        while (index + 1 >= (ptrdiff_t)primes.size()) {
+            if (!refillForward()) return 0;
+        }
+        return primes[++index];
+    }
+    
+    // Largest prime <= start on the first call, then the prime before the last one
+    uint64_t prevPrime() {
+        if (!positioned) position(false);
+        while (index <= 0) {
+            if (!refillBackward()) return 0;
+        }
+        return primes[--index];
+    }
+    
+private:
+    size_t segmentBytes;
+    uint64_t start;
+    bool positioned;
+    
+    // primes holds every prime in the wheel bytes [lowByte, highByte) and
+    // index is the position of the prime returned last
+    std::vector<uint64_t> primes;
+    uint64_t lowByte = 0, highByte = 0;
+    ptrdiff_t index = 0;
+    
+    std::unique_ptr<WheelSieve> forwardSieve;
+    uint64_t forwardEndByte = 0;
+    std::shared_ptr<const std::pmr::vector<uint32_t>> basePrimes;
+    uint64_t baseLimit = 0;
+    
+    // Loads primes around start, sieving in the direction of the first step,
+    // and places index just before (forward) or just after (backward) start
+    void position(bool forward) {
+        positioned = true;
+        if (forward) {
+            highByte = lowByte = start / WHEEL_SPAN;
+            refillForward();
+            index = (std::lower_bound(primes.begin(), primes.end(), start) - primes.begin()) - 1;
+        } else {
+            highByte = lowByte = start / WHEEL_SPAN + 1;
+            refillBackward();
+            index = std::upper_bound(primes.begin(), primes.end(), start) - primes.begin();
+        }
+    }
+    
+    // Largest value covered by the wheel bytes below endByte
+    static uint64_t valueBelowByte(uint64_t endByte) {
+        return endByte >= WHEEL_BYTES_64 ? UINT64_MAX : WHEEL_SPAN * endByte - 1;
+    }
+    
+    // Windows grow with sqrt(value) so finding first multiples stays cheap
+    // next to the sieving itself
+    uint64_t windowBytes(uint64_t byte, uint64_t maxBytes) const {
+        uint64_t bytes = std::max<uint64_t>(16 * segmentBytes, integerSqrt(valueBelowByte(byte + 1)));
+        return std::min(bytes, maxBytes);
+    }
+    
+    // Base primes are regenerated only when the bound at least quadruples
+    const std::shared_ptr<const std::pmr::vector<uint32_t>>& basePrimesFor(uint64_t n) {
+        if (!basePrimes || n > baseLimit) {
+            baseLimit = baseLimit > UINT64_MAX / 4 ? UINT64_MAX : std::max(n, 4 * baseLimit);
+            basePrimes = std::make_shared<const std::pmr::vector<uint32_t>>(wheelBasePrimes(baseLimit));
+        }
+        return basePrimes;
+    }
+    
+    bool refillForward() {
+        if (highByte >= WHEEL_BYTES_64) return false;
+        if (!forwardSieve || forwardSieve->nextByte() != highByte || highByte == forwardEndByte) {
+            forwardEndByte = std::min(WHEEL_BYTES_64, highByte + windowBytes(highByte, FORWARD_WINDOW_BYTES));
+            uint64_t n = valueBelowByte(forwardEndByte);
+            forwardSieve.reset(new WheelSieve(n, highByte, forwardEndByte, basePrimesFor(n), segmentBytes));
+        }
+        
+        forwardSieve->nextSegmentPrimes(primes);
+        lowByte = highByte;
+        highByte = forwardSieve->nextByte();
+        index = -1;
+        return true;
+    }
+    
+    bool refillBackward() {
+        if (lowByte == 0) return false;
+        uint64_t firstByte = lowByte - std::min(lowByte, windowBytes(lowByte, BACKWARD_WINDOW_BYTES));
+        uint64_t n = valueBelowByte(lowByte);
+        
+        primes.clear();
+        WheelSieve(n, firstByte, lowByte, basePrimesFor(n), segmentBytes).forEachPrime([&](uint64_t p) {
+            primes.push_back(p);
+        });
+        highByte = lowByte;
+        lowByte = firstByte;
+        index = primes.size();
+        return true;
+    }
+};
+
+// The primes in [lo, hi] as a range, produced lazily for range-based for loops
+class PrimeRange {
+public:
+    PrimeRange(uint64_t lo, uint64_t hi) : lo(lo), hi(hi) {}
+    
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = uint64_t;
+        using difference_type = ptrdiff_t;
+        using pointer = const uint64_t*;
+        using reference = const uint64_t&;
+        
+        iterator() = default;
+        iterator(PrimeIterator* primes, uint64_t hi) : primes(primes), hi(hi) { advance(); }
+        
+        const uint64_t& operator*() const { return value; }
+        iterator& operator++() { advance(); return *this; }
+        bool operator==(const iterator& other) const { return value == other.value; }
+        bool operator!=(const iterator& other) const { return value != other.value; }
+        
+    private:
+        PrimeIterator* primes = nullptr;
+        uint64_t hi = 0;
+        uint64_t value = 0;
+        
+        // 0 is never prime, so it doubles as the end marker
+        void advance() {
+            value = primes->nextPrime();
+            if (value > hi) value = 0;
+        }
+    };
+    
+    iterator begin() {
+        primes.jumpTo(lo);
+        return iterator(&primes, hi);
+    }
+    iterator end() const { return iterator(); }
+    
+private:
+    uint64_t lo, hi;
+    PrimeIterator primes;
+};
+
+// Bits of the 64-bit word of wheel bytes holding x whose value is at most x;
+// word w covers the values [240w, 240w + 240)
+inline uint64_t wheelWordBitsUpTo(uint64_t x) {
+    uint64_t byte = x / WHEEL_SPAN % 8;
+    uint64_t below = byte == 0 ? 0 : ~0ull >> (64 - 8 * byte);
+    return below | (uint64_t)wheelTables().residuesUpTo[x % WHEEL_SPAN] << (8 * byte);
+}
+
+// Primes <= n kept as the raw mod-30 wheel bits in 64-bit words, 240 numbers
+// per word: n / 30 bytes in all, against 4 bytes per number for a table of
+// ints or n / 8 bytes for a vector<bool>. Counting any range is a popcount per
+// word; extraction decodes set bits straight into a caller buffer.
+class PrimeBitset {
+public:
+    explicit PrimeBitset(uint64_t n) : n(n), words(n / WHEEL_SPAN / 8 + 2, 0) {
+        uint8_t* bytes = (uint8_t*)words.data();
+        WheelSieve(n).forEachSegment([&](uint64_t lowByte, const uint8_t* data, size_t length) {
+            std::memcpy(bytes + lowByte, data, length);
+        });
+    }
+    
+    uint64_t limit() const { return n; }
+    size_t memoryBytes() const { return words.size() * sizeof(uint64_t); }
+    
+    bool isPrime(uint64_t x) const {
+        if (x > n) return false;
+        if (x < 7) return x == 2 || x == 3 || x == 5;
+        int k = wheelTables().residueIndex[x % WHEEL_SPAN];
+        return k >= 0 && (((const uint8_t*)words.data())[x / WHEEL_SPAN] >> k & 1);
+    }
+    
+    // Number of primes in [lo, hi]
+    uint64_t count(uint64_t lo, uint64_t hi) const {
+        hi = std::min(hi, n);
+        if (lo > hi) return 0;
+        
+        uint64_t total = 0;
+        for (uint64_t p : {2, 3, 5}) total += lo <= p && p <= hi;
+        forEachWord(lo, hi, [&](uint64_t, uint64_t word) {
+            total += __builtin_popcountll(word);
+            return true;
+        });
+        return total;
+    }
+    
+    // Writes the primes of [lo, hi] to out in increasing order, stopping after
+    // capacity of them, and returns how many were written
+    size_t extract(uint64_t lo, uint64_t hi, uint64_t* out, size_t capacity) const {
+        hi = std::min(hi, n);
+        if (lo > hi) return 0;
+        
+        size_t written = 0;
+        for (uint64_t p : {2, 3, 5}) {
+            if (lo <= p && p <= hi && written < capacity) out[written++] = p;
+        }
+        
+        const WheelTables& tables = wheelTables();
+        forEachWord(lo, hi, [&](uint64_t base, uint64_t word) {
+            while (word && written < capacity) {
+                out[written++] = base + tables.wordOffset[__builtin_ctzll(word)];
+                word &= word - 1;
+            }
+            return written < capacity;
+        });
+        return written;
+    }
+    
+private:
+    uint64_t n;
+    std::vector<uint64_t> words;
+    
+    // Calls visit(base, word) for each word overlapping [lo, hi] with the bits
+    // outside the range cleared, base being the value of the word's first bit
+    // position minus its residue. Stops early when visit returns false.
+    template <typename Visit>
+    void forEachWord(uint64_t lo, uint64_t hi, Visit visit) const {
+        const uint64_t wordSpan = 8 * WHEEL_SPAN;
+        uint64_t first = lo / wordSpan, last = hi / wordSpan;
+        for (uint64_t w = first; w <= last; w++) {
+            uint64_t word = words[w];
+            if (w == first && lo % wordSpan != 0) word &= ~wheelWordBitsUpTo(lo - 1);
+            if (w == last) word &= wheelWordBitsUpTo(hi);
+            if (word && !visit(w * wordSpan, word)) return;
+        }
+    }
+};
+
+// Primes kept as wheel bits like PrimeBitset, but with no bound fixed up
+// front: every query past what is sieved extends the sieve by whole
+// segments, carrying each sieving prime's next multiple from one segment to
+// the next, so no number is ever sieved twice. A stream of queries therefore
+// costs time and memory in proportion to the largest number it reaches, not to
+// the sum of the queries. The base primes are read from SMALL_PRIMES and then
+// from the sieve's own finished bits, and the number of primes before every 8 words is
+// recorded as segments are added, so pi(x) is one lookup plus at most eight
+// popcounts at any size.
+class LazySieve {
+public:
+    explicit LazySieve(size_t segmentBytes = l1DataCacheSize())
+        : segmentBytes(std::max<size_t>(segmentBytes / BLOCK_BYTES * BLOCK_BYTES, BLOCK_BYTES)) {}
+    
+    // Every x < limit() is sieved; the limit only grows
+    uint64_t limit() const { return WHEEL_SPAN * 8 * words.size(); }
+    size_t memoryBytes() const {
+        return words.size() * sizeof(uint64_t) + ranks.size() * sizeof(uint64_t) +
+               sievingPrimes.size() * sizeof(SievingPrime);
+    }
+    
+    // Sieves segments until x is covered
+    void extendTo(uint64_t x) {
+        while (x >= limit()) sieveNextSegment(x / WORD_SPAN / BLOCK_WORDS * BLOCK_BYTES + BLOCK_BYTES);
+    }
+    
+    bool isPrime(uint64_t x) {
+        if (x < 7) return x == 2 || x == 3 || x == 5;
+        extendTo(x);
+        int k = wheelTables().residueIndex[x % WHEEL_SPAN];
+        return k >= 0 && (((const uint8_t*)words.data())[x / WHEEL_SPAN] >> k & 1);
+    }
+    
+    // pi(x), the number of primes <= x
+    uint64_t primeCount(uint64_t x) {
+        uint64_t small = (x >= 2) + (x >= 3) + (x >= 5);
+        if (x < 7) return small;
+        extendTo(x);
+        
+        uint64_t w = x / WORD_SPAN;
+        uint64_t first = w - w % BLOCK_WORDS;
+        uint64_t total = small + ranks[first / BLOCK_WORDS];
+        for (uint64_t i = first; i < w; i++) total += __builtin_popcountll(words[i]);
+        return total + __builtin_popcountll(words[w] & wheelWordBitsUpTo(x));
+    }
+    
+    // Number of primes in [lo, hi]
+    uint64_t count(uint64_t lo, uint64_t hi) {
+        if (lo > hi) return 0;
+        return primeCount(hi) - (lo > 0 ? primeCount(lo - 1) : 0);
+    }
+    
+    // Calls callback(p) for every prime p in [lo, hi] in increasing order
+    template <typename Callback>
+    void forEachPrime(uint64_t lo, uint64_t hi, Callback callback) {
+        if (lo > hi) return;
+        for (uint64_t p : {2, 3, 5}) {
+            if (lo <= p && p <= hi) callback(p);
+        }
+        if (hi < 7) return;
+        extendTo(hi);
+        
+        const WheelTables& tables = wheelTables();
+        uint64_t first = lo / WORD_SPAN, last = hi / WORD_SPAN;
+        for (uint64_t w = first; w <= last; w++) {
+            uint64_t word = words[w];
+            if (w == first && lo % WORD_SPAN != 0) word &= ~wheelWordBitsUpTo(lo - 1);
+            if (w == last) word &= wheelWordBitsUpTo(hi);
+            while (word) {
+                callback(w * WORD_SPAN + tables.wordOffset[__builtin_ctzll(word)]);
+                word &= word - 1;
+            }
+        }
+    }
+    
+    // Primes in [lo, hi]
+    std::vector<uint64_t> primesInRange(uint64_t lo, uint64_t hi) {
+        std::vector<uint64_t> primes;
+        forEachPrime(lo, hi, [&](uint64_t p) { primes.push_back(p); });
+        return primes;
+    }
+    
+private:
+    static constexpr uint64_t WORD_SPAN = 8 * WHEEL_SPAN;
+    static constexpr uint64_t BLOCK_WORDS = 8;
+    static constexpr size_t BLOCK_BYTES = 8 * BLOCK_WORDS;
+    
+    // Segments ending at or below this byte sieve with base primes below 65521
+    // only, all taken from SMALL_PRIMES
+    static constexpr uint64_t SMALL_BASE_BYTES = 65521ull * 65521 / WHEEL_SPAN;
+    
+    size_t segmentBytes;
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> ranks;   // ranks[b]: primes above 5 in the words before block b
+    std::vector<SievingPrime> sievingPrimes;
+    uint32_t nextSmallPrime = 6;   // index of 17 in SMALL_PRIMES
+    uint64_t nextBase = 17;        // smallest base prime not sieving yet
+    uint64_t primesSieved = 0;
+    
+    // Smallest prime above p, from SMALL_PRIMES or the finished words; the
+    // segment bound in sieveNextSegment keeps it inside them
+    uint64_t primeAfter(uint64_t p) {
+        if (nextSmallPrime + 1 < SMALL_PRIME_COUNT) return SMALL_PRIMES.primes[++nextSmallPrime];
+        uint64_t w = p / WORD_SPAN;
+        uint64_t word = words[w] & ~wheelWordBitsUpTo(p);
+        while (word == 0 && w + 1 < words.size()) word = words[++w];
+        assert(word != 0);
+        return w * WORD_SPAN + wheelTables().wordOffset[__builtin_ctzll(word)];
+    }
+    
+    // Last byte + 1 the segment starting at lowByte may reach. Past
+    // SMALL_BASE_BYTES the base primes are read from the words sieved before
+    // lowByte: the largest one used is below sqrt(30 * highByte) and the next
+    // one after it below twice that (Bertrand), so 30 * highByte may not
+    // exceed (30 * lowByte)^2 / 4.
+    static uint64_t segmentBound(uint64_t lowByte) {
+        uint64_t lowValue = WHEEL_SPAN * lowByte;
+        if (lowValue >= 1ull << 32) return UINT64_MAX;
+        return std::max(SMALL_BASE_BYTES, lowValue * lowValue / 4 / WHEEL_SPAN) / BLOCK_BYTES * BLOCK_BYTES;
+    }
+    
+    // Sieves the next segment in place at the end of words, ending at
+    // targetByte when that is within segmentBytes and segmentBound. Segments
+    // are at least an eighth of what is sieved already (up to segmentBytes),
+    // so a stream of slowly growing queries still sieves in a few large steps.
+    void sieveNextSegment(uint64_t targetByte) {
+        uint64_t lowByte = words.size() * 8;
+        uint64_t minimum = std::min<uint64_t>(segmentBytes, std::max<uint64_t>(lowByte / 8 / BLOCK_BYTES * BLOCK_BYTES, BLOCK_BYTES));
+        size_t bytes = std::min<uint64_t>(segmentBytes, std::max(targetByte - lowByte, minimum));
+        uint64_t highByte = std::min(lowByte + bytes, segmentBound(lowByte));
+        bytes = highByte - lowByte;
+        
+        // Activated before words grows, so primeAfter only sees finished words
+        while (nextBase * nextBase / WHEEL_SPAN < highByte) {
+            sievingPrimes.push_back(wheelSievingPrime(nextBase, lowByte));
+            nextBase = primeAfter(nextBase);
+        }
+        words.resize(highByte / 8);
+        uint8_t* data = (uint8_t*)words.data() + lowByte;
+        presieveWheelBytes(data, lowByte, bytes);
+        for (SievingPrime& sp : sievingPrimes) crossOffWheelMultiples(sp, data, lowByte, bytes);
+        
+        for (uint64_t w = lowByte / 8; w < highByte / 8; w++) {
+            if (w % BLOCK_WORDS == 0) ranks.push_back(primesSieved);
+            primesSieved += __builtin_popcountll(words[w]);
+        }
+    }
+};
+
+// Linear Sieve (Sieve of Euler), appending the primes <= n to primes; the
+// flag array comes from resource
+template <typename T, typename Primes>
+void linearSieveInto(T n, Primes& primes, std::pmr::memory_resource* resource) {
+    static_assert(std::is_integral<T>::value, "sieve bound must be an integer type");
+    if (n < 2) return;
+    
+    std::vector<bool, std::pmr::polymorphic_allocator<bool>> isPrime((size_t)n + 1, true, resource);
+    isPrime[0] = isPrime[1] = false;
+    size_t first = primes.size();
+    primes.reserve(first + primeCountUpperBound(n));
+    
+    for (T i = 2; i <= n; i++) {
+        if (isPrime[i]) {
+            primes.push_back(i);
+        }
+        
+        for (size_t j = first; j < primes.size() && primes[j] <= n / i; j++) {
+            isPrime[i * primes[j]] = false;
+            if (i % primes[j] == 0) {
+                break; // Key optimization: avoid marking same number multiple times
+            }
+        }
+        
+        if (i == n) break; // i++ would wrap when n is the largest T
+    }
+}
+
+// Linear Sieve (Sieve of Euler)
+template <typename T>
+std::vector<T> linearSieve(T n) {
+    std::vector<T> primes;
+    linearSieveInto(n, primes, std::pmr::get_default_resource());
+    return primes;
+}
+
+// The same with the flags and the result taken from resource
+template <typename T>
+std::pmr::vector<T> linearSieve(T n, std::pmr::memory_resource* resource) {
+    std::pmr::vector<T> primes(resource);
+    linearSieveInto(n, primes, resource);
+    return primes;
+}
+
+// Sieve of Atkin: n is prime (for n coprime to 60) exactly when it is
+// squarefree and one of three binary quadratic forms, chosen by n mod 60,
+// has an odd number of representations of it. Flipping a bit per
+// representation costs O(n) work in all, after which multiples of prime
+// squares are removed. The candidates are odd, so only odd n are stored.
+template <typename T>
+std::vector<T> sieveOfAtkin(T n) {
+    static_assert(std::is_integral<T>::value, "sieve bound must be an integer type");
+    std::vector<T> primes;
+    for (T p : {2, 3, 5}) {
+        if (p <= n) primes.push_back(p);
+    }
+    if (n < 7) return primes;
+    
+    // Form used for each residue mod 60: 1 for 4x^2 + y^2, 2 for 3x^2 + y^2,
+    // 3 for 3x^2 - y^2 with x > y, 0 for residues sharing a factor with 60
+    int8_t form[60] = {};
+    for (int r : {1, 13, 17, 29, 37, 41, 49, 53}) form[r] = 1;
+    for (int r : {7, 19, 31, 43}) form[r] = 2;
+    for (int r : {11, 23, 47, 59}) form[r] = 3;
+    
+    uint64_t limit = n;
+    std::vector<uint64_t> bits(limit / 128 + 1, 0);
+    auto flip = [&](uint64_t m) { bits[m / 128] ^= 1ull << (m / 2 % 64); };
+    auto test = [&](uint64_t m) { return bits[m / 128] >> (m / 2 % 64) & 1; };
+    
+    // 4x^2 + y^2 is odd only for odd y
+    for (uint64_t x = 1; 4 * x * x + 1 <= limit; x++) {
+        for (uint64_t y = 1, m; (m = 4 * x * x + y * y) <= limit; y += 2) {
+            if (form[m % 60] == 1) flip(m);
+        }
+    }
+    // 3x^2 + y^2 = 7 (mod 12) needs x odd and y even
+    for (uint64_t x = 1; 3 * x * x + 4 <= limit; x += 2) {
+        for (uint64_t y = 2, m; (m = 3 * x * x + y * y) <= limit; y += 2) {
+            if (form[m % 60] == 2) flip(m);
+        }
+    }
+    // 3x^2 - y^2 = 11 (mod 12) needs x + y odd; y runs down from x - 1 so m grows
+    for (uint64_t x = 2; 2 * x * x + 2 * x - 1 <= limit; x++) {
+        for (uint64_t y = x - 1, m; (m = 3 * x * x - y * y) <= limit; y -= 2) {
+            if (form[m % 60] == 3) flip(m);
+            if (y < 3) break;
+        }
+    }
+    
+    for (uint64_t r = 7; r <= limit / r; r += 2) {
+        if (!test(r)) continue;
+        for (uint64_t m = r * r;; m += 2 * r * r) {
+            if (test(m)) flip(m);
+            if (limit - m < 2 * r * r) break;
+        }
+    }
+    
+    for (uint64_t m = 7; m <= limit; m += 2) {
+        if (test(m)) primes.push_back(m);
+    }
+    return primes;
+}
+
+// Residues of the mod-210 wheel: the 48 values below 210 coprime to
+// 2 * 3 * 5 * 7, their positions, and the gap from each to the next.
+// A candidate m is stored at slot 48 * (m / 210) + index[m % 210]; for a
+// prime p = 210a + residue[r] stepping its multiple p * q to p * (q + gap[j]),
+// with q at wheel position j, the slot moves by 48 * a * gap[j] + slotStep[r][j].
+struct Wheel210Tables {
+    int8_t index[210];
+    uint8_t residue[48];
+    uint8_t gap[48];
+    int16_t slotStep[48][48];
+    
+    Wheel210Tables() {
+        int count = 0;
+        for (int i = 0; i < 210; i++) {
+            bool coprime = i % 2 && i % 3 && i % 5 && i % 7;
+            index[i] = coprime ? count : -1;
+            if (coprime) residue[count++] = i;
+        }
+        for (int k = 0; k < 48; k++) {
+            gap[k] = k == 47 ? 210 + residue[0] - residue[47] : residue[k + 1] - residue[k];
+        }
+        for (int r = 0; r < 48; r++) {
+            for (int j = 0; j < 48; j++) {
+                int from = residue[r] * residue[j], to = residue[r] * (residue[j] + gap[j]);
+                slotStep[r][j] = (to / 210 - from / 210) * 48 + index[to % 210] - index[from % 210];
+            }
+        }
+    }
+};
+
+inline const Wheel210Tables& wheel210Tables() {
+    static const Wheel210Tables tables;
+    return tables;
+}
+
+// Segmented sieve on the mod-210 wheel: only the 48 of every 210 numbers
+// coprime to 2, 3, 5 and 7 are stored, one byte each, and every sieving
+// prime p steps through just the multiples p * q with q on the wheel.
+// Segments of L1 size carry each prime's next multiple and wheel position.
+template <typename T>
+std::vector<T> wheel210Sieve(T n) {
+    static_assert(std::is_integral<T>::value, "sieve bound must be an integer type");
+    std::vector<T> primes;
+    for (T p : {2, 3, 5, 7}) {
+        if (p <= n) primes.push_back(p);
+    }
+    if (n < 11) return primes;
+    
+    const Wheel210Tables& wheel = wheel210Tables();
+    uint64_t limit = n;
+    
+    // Sieving prime p = 210a + residue[r] with the slot of its next multiple
+    // p * q and the wheel position j of q
+    struct Crosser {
+        uint64_t slot;
+        uint32_t rotationStep;   // 48 * a
+        uint8_t r, j;
+    };
+    std::vector<Crosser> crossers;
+    for (uint64_t p : segmentedSieve<uint64_t>(integerSqrt(limit))) {
+        if (p < 11) continue;
+        uint64_t square = p * p;
+        uint8_t r = wheel.index[p % 210];
+        crossers.push_back({square / 210 * 48 + wheel.index[square % 210], (uint32_t)(p / 210 * 48), r, r});
+    }
+    
+    uint64_t rotations = limit / 210 + 1;
+    uint64_t segmentRotations = std::max<uint64_t>(l1DataCacheSize() / 48, 1);
+    std::vector<uint8_t> segment(segmentRotations * 48);
+    for (uint64_t low = 0; low < rotations; low += segmentRotations) {
+        uint64_t high = std::min(low + segmentRotations, rotations);
+        std::fill(segment.begin(), segment.begin() + (high - low) * 48, 1);
+        
+        uint64_t lowSlot = low * 48, highSlot = high * 48;
+        for (Crosser& c : crossers) {
+            uint64_t slot = c.slot;
+            uint32_t j = c.j;
+            const int16_t* steps = wheel.slotStep[c.r];
+            while (slot < highSlot) {
+                segment[slot - lowSlot] = 0;
+                slot += (uint64_t)c.rotationStep * wheel.gap[j] + steps[j];
+                j = j == 47 ? 0 : j + 1;
+            }
+            c.slot = slot;
+            c.j = j;
+        }
+        
+        // Branch-free extraction: every candidate is written and the end only
+        // advances past primes. 1 and values above n are cleared first.
+        if (low == 0) segment[0] = 0;
+        for (uint64_t slot = highSlot - 1; slot >= lowSlot && slot / 48 * 210 + wheel.residue[slot % 48] > limit; slot--) {
+            segment[slot - lowSlot] = 0;
+        }
+        size_t end = primes.size();
+        primes.resize(end + (highSlot - lowSlot));
+        T* out = primes.data();
+        for (uint64_t r = low; r < high; r++) {
+            const uint8_t* row = &segment[(r - low) * 48];
+            for (int k = 0; k < 48; k++) {
+                out[end] = r * 210 + wheel.residue[k];
+                end += row[k];
+            }
+        }
+        primes.resize(end);
+    }
+    
+    return primes;
+}
+
+// Function to extract primes from boolean array
+template <typename T = int>
+std::vector<T> extractPrimes(const std::vector<bool>& isPrime) {
+    std::vector<T> primes;
+    for (size_t i = 0; i < isPrime.size(); i++) {
+        if (isPrime[i]) {
+            primes.push_back(i);
+        }
+    }
+    return primes;
+}
+
+} // namespace number_elite
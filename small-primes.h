@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+namespace number_elite {
+
+// Primes below 2^16 and a primality bitmap over the same range, built by the
+// compiler: nothing is sieved at startup, and the 4 KB bitmap plus the 13 KB
+// prime list stay in the binary's read-only data. Every n below 2^32 has its
+// smallest prime factor in the list.
+const uint32_t SMALL_PRIME_LIMIT = 1 << 16;
+const uint32_t SMALL_PRIME_COUNT = 6542;
+
+struct SmallPrimeTables {
+    uint16_t primes[SMALL_PRIME_COUNT] = {};
+    // Bit n / 2 is set for odd primes n; even n are handled by the caller
+    uint64_t oddBitmap[SMALL_PRIME_LIMIT / 128] = {};
+};
+
+// Odd-only sieve of Eratosthenes run at compile time
+constexpr SmallPrimeTables buildSmallPrimeTables() {
+    SmallPrimeTables tables;
+    for (uint32_t i = 0; i < SMALL_PRIME_LIMIT / 128; i++) tables.oddBitmap[i] = ~0ull;
+    tables.oddBitmap[0] &= ~1ull; // 1 is not prime
+    for (uint32_t p = 3; p * p < SMALL_PRIME_LIMIT; p += 2) {
+        if (!(tables.oddBitmap[p / 128] >> (p / 2 % 64) & 1)) continue;
+        for (uint32_t m = p * p; m < SMALL_PRIME_LIMIT; m += 2 * p) {
+            tables.oddBitmap[m / 128] &= ~(1ull << (m / 2 % 64));
+        }
+    }
+    
+    uint32_t count = 0;
+    tables.primes[count++] = 2;
+    for (uint32_t n = 3; n < SMALL_PRIME_LIMIT; n += 2) {
+        if (tables.oddBitmap[n / 128] >> (n / 2 % 64) & 1) tables.primes[count++] = n;
+    }
+    return tables;
+}
+
+inline constexpr SmallPrimeTables SMALL_PRIMES = buildSmallPrimeTables();
+
+static_assert(SMALL_PRIMES.primes[SMALL_PRIME_COUNT - 1] == 65521, "the table must end at the largest prime below 2^16");
+
+// Primality of n < 2^16 with one bitmap lookup
+constexpr bool isSmallPrime(uint32_t n) {
+    if (n % 2 == 0) return n == 2;
+    return SMALL_PRIMES.oddBitmap[n / 128] >> (n / 2 % 64) & 1;
+}
+
+} // namespace number_elite
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace number_elite {
+
+// Prime factorization of a 32-bit number held inline: no number below 2^32
+// has more than 9 distinct prime factors, so queries never allocate
+struct SmallFactorization {
+    uint32_t prime[9];
+    uint8_t exponent[9];
+    int count = 0;
+};
+
+// Smallest prime factor of every n <= limit, built once by the linear sieve
+// (each composite is visited exactly once, by its smallest prime). Only odd n
+// are stored, at index n / 2, so the table takes 2 bytes per number; even
+// numbers have smallest prime factor 2 implicitly. Every query then walks the
+// table in O(log n) steps without allocating. Queries take 1 <= n <= limit.
+class SmallestPrimeFactorTable {
+public:
+    explicit SmallestPrimeFactorTable(uint32_t limit) : limit(limit), spf(limit / 2 + 1, 0) {
+        std::vector<uint32_t> primes;
+        for (uint64_t i = 3; i <= limit; i += 2) {
+            uint32_t& smallest = spf[i / 2];
+            if (smallest == 0) {
+                smallest = i;
+                primes.push_back(i);
+            }
+            for (uint32_t p : primes) {
+                if (p > smallest || p * i > limit) break;
+                spf[p * i / 2] = p;
+            }
+        }
+    }
+    
+    uint32_t maxValue() const { return limit; }
+    
+    // Smallest prime factor of 2 <= n <= limit
+    uint32_t smallestPrimeFactor(uint32_t n) const {
+        return n % 2 == 0 ? 2 : spf[n / 2];
+    }
+    
+    bool isPrime(uint32_t n) const {
+        return n >= 2 && smallestPrimeFactor(n) == n;
+    }
+    
+    // Calls visit(p, e) for every prime power p^e exactly dividing n, p increasing
+    template <typename Visitor>
+    void forEachPrimeFactor(uint32_t n, Visitor visit) const {
+        if (n >= 2 && n % 2 == 0) {
+            int e = __builtin_ctz(n);
+            n >>= e;
+            visit(2u, e);
+        }
+        while (n > 1) {
+            uint32_t p = spf[n / 2];
+            int e = 0;
+            do {
+                n /= p;
+                e++;
+            } while (n % p == 0);
+            visit(p, e);
+        }
+    }
+    
+    SmallFactorization factorize(uint32_t n) const {
+        SmallFactorization result;
+        forEachPrimeFactor(n, [&](uint32_t p, int e) {
+            result.prime[result.count] = p;
+            result.exponent[result.count++] = e;
+        });
+        return result;
+    }
+    
+    // d(n), the number of divisors
+    uint32_t divisorCount(uint32_t n) const {
+        uint32_t count = 1;
+        forEachPrimeFactor(n, [&](uint32_t, int e) { count *= e + 1; });
+        return count;
+    }
+    
+    // sigma(n), the sum of divisors
+    uint64_t divisorSum(uint32_t n) const {
+        uint64_t sum = 1;
+        forEachPrimeFactor(n, [&](uint32_t p, int e) {
+            uint64_t term = 1, power = 1;
+            for (int i = 0; i < e; i++) term += power *= p;
+            sum *= term;
+        });
+        return sum;
+    }
+    
+    // phi(n), Euler's totient
+    uint32_t totient(uint32_t n) const {
+        uint32_t result = n;
+        forEachPrimeFactor(n, [&](uint32_t p, int) { result -= result / p; });
+        return result;
+    }
+    
+    // mu(n), the Moebius function
+    int mobius(uint32_t n) const {
+        int result = 1;
+        forEachPrimeFactor(n, [&](uint32_t, int e) { result = e > 1 ? 0 : -result; });
+        return result;
+    }
+    
+private:
+    uint32_t limit;
+    std::vector<uint32_t> spf;
+};
+
+} // namespace number_elite
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <vector>
+#include "small-primes.h"
+
+namespace number_elite {
+
+// Primality and prime listing by trial division, templated on the integer
+// type. Bounds compare d <= n / d rather than d * d <= n so they hold up to
+// the largest value of T.
+
+// Trial Division Method - Basic primality test
+template <typename T>
+constexpr bool isPrimeTrialDivision(T n) {
+    if (n <= 1) return false;
+    if (n <= 3) return true;
+    if (n % 2 == 0 || n % 3 == 0) return false;
+    
+    for (T i = 5; i <= n / i; i += 6) {
+        if (n % i == 0 || n % (i + 2) == 0)
+            return false;
+    }
+    return true;
+}
+
+// Method 1: Simple Trial Division
+template <typename T = int>
+std::vector<T> primeTillNSimple(T n) {
+    std::vector<T> primes;
+    
+    for (T i = 2; i <= n; i++) {
+        bool isPrime = true;
+        
+        for (T j = 2; j <= i / j; j++) {
+            if (i % j == 0) {
+                isPrime = false;
+                break;
+            }
+        }
+        
+        if (isPrime) {
+            primes.push_back(i);
+        }
+        if (i == n) break;
+    }
+    
+    return primes;
+}
+
+// Method 2: Optimized Trial Division
+template <typename T = int>
+std::vector<T> primeTillNOptimized(T n) {
+    if (n < 2) return {};
+    
+    std::vector<T> primes;
+    primes.push_back(2); // First prime
+    
+    for (T i = 3; i <= n; i += 2) { // Check only odd numbers
+        bool isPrime = true;
+        
+        // Check divisibility only by primes, up to sqrt(i): the compile-time
+        // table holds every odd divisor needed below 2^32, and the primes
+        // found so far take over past the end of it
+        bool checked = false;
+        for (uint32_t k = 1; k < SMALL_PRIME_COUNT; k++) {
+            T prime = SMALL_PRIMES.primes[k];
+            if (prime > i / prime) {
+                checked = true;
+                break;
+            }
+            
+            if (i % prime == 0) {
+                isPrime = false;
+                break;
+            }
+        }
+        for (size_t k = SMALL_PRIME_COUNT; isPrime && !checked; k++) {
+            T prime = primes[k];
+            if (prime > i / prime) break;
+            
+            if (i % prime == 0) isPrime = false;
+        }
+        
+        if (isPrime) {
+            primes.push_back(i);
+        }
+        if (n - i < 2) break;
+    }
+    
+    return primes;
+}
+
+// Method 3: Simple Sieve (not the standard Sieve of Eratosthenes)
+template <typename T = int>
+std::vector<T> primeTillNSieve(T n) {
+    if (n < 2) return {};
+    
+    std::vector<bool> isPrime((size_t)n + 1, true);
+    std::vector<T> primes;
+    
+    isPrime[0] = isPrime[1] = false;
+    
+    for (T i = 2; i <= n; i++) {
+        if (isPrime[i]) {
+            primes.push_back(i);
+            
+            // Mark multiples as composite
+            for (T j = i; n - j >= i;) {
+                j += i;
+                isPrime[j] = false;
+            }
+        }
+        if (i == n) break;
+    }
+    
+    return primes;
+}
+
+// Method 4: Using 6k±1 optimization
+template <typename T = int>
+std::vector<T> primeTillN6kOptimization(T n) {
+    if (n < 2) return {};
+    
+    std::vector<T> primes;
+    
+    if (n >= 2) primes.push_back(2);
+    if (n >= 3) primes.push_back(3);
+    
+    // All primes > 3 are of the form 6k±1
+    for (T i = 5; i <= n; i += 6) {
+        // Check 6k-1
+        if (isPrimeTrialDivision(i)) {
+            primes.push_back(i);
+        }
+        
+        // Check 6k+1
+        if (n - i >= 2 && isPrimeTrialDivision(i + 2)) {
+            primes.push_back(i + 2);
+        }
+        if (n - i < 6) break;
+    }
+    
+    return primes;
+}
+
+} // namespace number_elite